@@ -0,0 +1,143 @@
+#include "BitmapFont.h"
+#include "Logger.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    struct GlyphPattern {
+        char character;
+        unsigned char rows[BitmapFont::GLYPH_HEIGHT]; // bit 4 = leftmost column
+    };
+
+    constexpr GlyphPattern GLYPHS[] = {
+        { '0', { 0b01110, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110 } },
+        { '1', { 0b00100, 0b01100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110 } },
+        { '2', { 0b01110, 0b10001, 0b00001, 0b00110, 0b01000, 0b10000, 0b11111 } },
+        { '3', { 0b01110, 0b10001, 0b00001, 0b00110, 0b00001, 0b10001, 0b01110 } },
+        { '4', { 0b00010, 0b00110, 0b01010, 0b10010, 0b11111, 0b00010, 0b00010 } },
+        { '5', { 0b11111, 0b10000, 0b11110, 0b00001, 0b00001, 0b10001, 0b01110 } },
+        { '6', { 0b01110, 0b10001, 0b10000, 0b11110, 0b10001, 0b10001, 0b01110 } },
+        { '7', { 0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b01000, 0b01000 } },
+        { '8', { 0b01110, 0b10001, 0b10001, 0b01110, 0b10001, 0b10001, 0b01110 } },
+        { '9', { 0b01110, 0b10001, 0b10001, 0b01111, 0b00001, 0b10001, 0b01110 } },
+        { 'A', { 0b01110, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001, 0b10001 } },
+        { 'B', { 0b11110, 0b10001, 0b10001, 0b11110, 0b10001, 0b10001, 0b11110 } },
+        { 'C', { 0b01110, 0b10001, 0b10000, 0b10000, 0b10000, 0b10001, 0b01110 } },
+        { 'D', { 0b11110, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b11110 } },
+        { 'E', { 0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b11111 } },
+        { 'F', { 0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b10000 } },
+        { 'G', { 0b01110, 0b10001, 0b10000, 0b10111, 0b10001, 0b10001, 0b01110 } },
+        { 'H', { 0b10001, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001, 0b10001 } },
+        { 'I', { 0b01110, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110 } },
+        { 'J', { 0b00111, 0b00010, 0b00010, 0b00010, 0b00010, 0b10010, 0b01100 } },
+        { 'K', { 0b10001, 0b10010, 0b10100, 0b11000, 0b10100, 0b10010, 0b10001 } },
+        { 'L', { 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b11111 } },
+        { 'M', { 0b10001, 0b11011, 0b10101, 0b10101, 0b10001, 0b10001, 0b10001 } },
+        { 'N', { 0b10001, 0b11001, 0b10101, 0b10011, 0b10001, 0b10001, 0b10001 } },
+        { 'O', { 0b01110, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110 } },
+        { 'P', { 0b11110, 0b10001, 0b10001, 0b11110, 0b10000, 0b10000, 0b10000 } },
+        { 'R', { 0b11110, 0b10001, 0b10001, 0b11110, 0b10010, 0b10001, 0b10001 } },
+        { 'S', { 0b01111, 0b10000, 0b10000, 0b01110, 0b00001, 0b00001, 0b11110 } },
+        { 'T', { 0b11111, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100 } },
+        { 'U', { 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110 } },
+        { 'V', { 0b10001, 0b10001, 0b10001, 0b10001, 0b01010, 0b01010, 0b00100 } },
+        { 'W', { 0b10001, 0b10001, 0b10001, 0b10101, 0b10101, 0b11011, 0b10001 } },
+        { 'X', { 0b10001, 0b01010, 0b00100, 0b00100, 0b00100, 0b01010, 0b10001 } },
+        { 'Y', { 0b10001, 0b10001, 0b01010, 0b00100, 0b00100, 0b00100, 0b00100 } },
+        { 'Z', { 0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b10000, 0b11111 } },
+        { '.', { 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00100 } },
+        { '/', { 0b00001, 0b00010, 0b00010, 0b00100, 0b00100, 0b01000, 0b10000 } },
+        { '|', { 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100 } },
+        { '=', { 0b00000, 0b00000, 0b11111, 0b00000, 0b11111, 0b00000, 0b00000 } },
+        { ':', { 0b00000, 0b00100, 0b00000, 0b00000, 0b00000, 0b00100, 0b00000 } }
+    };
+    constexpr int GLYPH_COUNT = sizeof(GLYPHS) / sizeof(GLYPHS[0]);
+    static_assert(GLYPH_COUNT < 128, "glyph indices are stored as signed char");
+
+    // Each glyph gets a cell one pixel wider than itself, so neighbours never touch
+    constexpr int CELL_WIDTH = BitmapFont::GLYPH_WIDTH + 1;
+}
+
+BitmapFont::~BitmapFont() {
+    clear();
+}
+
+bool BitmapFont::init(SDL_Renderer* sdlRenderer) {
+    renderer = sdlRenderer;
+    for (auto& index : glyphIndex) {
+        index = -1;
+    }
+
+    textureWidth = GLYPH_COUNT * CELL_WIDTH;
+    std::vector<Uint32> pixels(textureWidth * GLYPH_HEIGHT, 0);
+    for (int glyph = 0; glyph < GLYPH_COUNT; ++glyph) {
+        glyphIndex[(unsigned char)GLYPHS[glyph].character] = (signed char)glyph;
+        for (int row = 0; row < GLYPH_HEIGHT; ++row) {
+            for (int col = 0; col < GLYPH_WIDTH; ++col) {
+                if (GLYPHS[glyph].rows[row] & (1 << (GLYPH_WIDTH - 1 - col))) {
+                    pixels[row * textureWidth + glyph * CELL_WIDTH + col] = 0xFFFFFFFF;
+                }
+            }
+        }
+    }
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, textureWidth, GLYPH_HEIGHT);
+    if (!texture) {
+        LOG_ERROR(LogCategory::ASSETS, "Unable to create bitmap font texture! SDL Error: %s", SDL_GetError());
+        return false;
+    }
+    SDL_UpdateTexture(texture, nullptr, pixels.data(), textureWidth * (int)sizeof(Uint32));
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    // Scaled glyphs must stay blocky
+    SDL_SetTextureScaleMode(texture, SDL_ScaleModeNearest);
+    return true;
+}
+
+void BitmapFont::clear() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+int BitmapFont::measure(const char* text, int scale) {
+    return (int)std::strlen(text) * ADVANCE * scale;
+}
+
+void BitmapFont::drawText(const char* text, int x, int y, int scale, SDL_Color color) {
+    if (!texture || !text) return;
+
+    vertices.clear();
+    indices.clear();
+    float u = 1.0f / textureWidth;
+    float w = (float)(GLYPH_WIDTH * scale);
+    float h = (float)(GLYPH_HEIGHT * scale);
+    float top = (float)y;
+
+    int currentX = x;
+    for (const char* c = text; *c; ++c, currentX += ADVANCE * scale) {
+        unsigned char character = (unsigned char)*c;
+        if (character >= 128 || glyphIndex[character] < 0) continue;
+
+        float u0 = glyphIndex[character] * CELL_WIDTH * u;
+        float u1 = u0 + GLYPH_WIDTH * u;
+        float left = (float)currentX;
+        int base = (int)vertices.size();
+        vertices.push_back({ { left, top }, color, { u0, 0.0f } });
+        vertices.push_back({ { left + w, top }, color, { u1, 0.0f } });
+        vertices.push_back({ { left + w, top + h }, color, { u1, 1.0f } });
+        vertices.push_back({ { left, top + h }, color, { u0, 1.0f } });
+        const int quadIndices[6] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+        indices.insert(indices.end(), quadIndices, quadIndices + 6);
+    }
+
+    if (!vertices.empty()) {
+        SDL_RenderGeometry(renderer, texture, vertices.data(), (int)vertices.size(), indices.data(), (int)indices.size());
+    }
+}
+
+void BitmapFont::drawNumber(int number, int x, int y, int scale, SDL_Color color) {
+    char digits[16];
+    snprintf(digits, sizeof(digits), "%d", number);
+    drawText(digits, x, y, scale, color);
+}
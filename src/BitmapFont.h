@@ -0,0 +1,39 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+
+// The built-in 5x7 pixel font used by the HUD and shop when no TTF font is
+// needed. The glyph table is baked into one small white texture at init; a
+// string becomes one textured quad per character, tinted through the vertex
+// color and drawn with a single SDL_RenderGeometry call. Vertex and index
+// buffers are reused, so drawing allocates nothing once they have grown.
+class BitmapFont {
+public:
+    static const int GLYPH_WIDTH = 5;
+    static const int GLYPH_HEIGHT = 7;
+    static const int ADVANCE = 6; // glyph width plus one pixel of spacing, before scaling
+
+    BitmapFont() = default;
+    ~BitmapFont();
+
+    bool init(SDL_Renderer* renderer);
+    void clear();
+
+    // Unknown characters (and lowercase letters) advance without drawing
+    void drawText(const char* text, int x, int y, int scale = 1, SDL_Color color = { 255, 255, 255, 255 });
+    void drawNumber(int number, int x, int y, int scale = 1, SDL_Color color = { 255, 255, 255, 255 });
+
+    static int measure(const char* text, int scale = 1);
+
+private:
+    BitmapFont(const BitmapFont&) = delete;
+    BitmapFont& operator=(const BitmapFont&) = delete;
+
+    SDL_Renderer* renderer = nullptr;
+    SDL_Texture* texture = nullptr;
+    int textureWidth = 0;
+    signed char glyphIndex[128] = {}; // ASCII -> column in the texture, -1 if none
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
@@ -1,13 +1,18 @@
 #include "Booster.h"
+#include "TextureCache.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
 #include <iostream>
 
 Booster::Booster(const Vector2& spawnPosition, float maxLifetime)
     : position(spawnPosition), radius(16.0f), alive(true), lifetime(0.0f), maxLifetime(maxLifetime),
       texture(nullptr), textureWidth(0), textureHeight(0) {}
 
-Booster::~Booster() {}
+Booster::~Booster() {
+    TextureCache::instance().release(texture);
+}
 
-void Booster::initialize(SDL_Renderer* renderer) {
+void Booster::initialize() {
     // Base class doesn't load specific texture - derived classes should override
 }
 
@@ -24,17 +29,10 @@ void Booster::render(SDL_Renderer* renderer) {
     
     // Base class doesn't render specific texture - derived classes should override
     // Fallback: draw colored circle
-    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // Yellow default
     int r = static_cast<int>(radius);
     int cx = static_cast<int>(position.x);
     int cy = static_cast<int>(position.y);
-    for (int x = -r; x <= r; ++x) {
-        for (int y = -r; y <= r; ++y) {
-            if (x * x + y * y <= r * r) {
-                SDL_RenderDrawPoint(renderer, cx + x, cy + y);
-            }
-        }
-    }
+    PrimitiveCache::instance().drawCircle(cx, cy, r, { 255, 255, 0, 255 });
     
     // Render progress bar
     renderProgressBar(renderer);
@@ -47,10 +45,11 @@ void Booster::renderProgressBar(SDL_Renderer* renderer) {
     int barX = static_cast<int>(position.x - PROGRESS_BAR_WIDTH / 2);
     int barY = static_cast<int>(position.y + radius + PROGRESS_BAR_OFFSET_Y);
     
+    SpriteBatch& batch = SpriteBatch::instance();
+
     // Draw background (dark gray)
-    SDL_SetRenderDrawColor(renderer, 64, 64, 64, 255);
     SDL_Rect bgRect = {barX, barY, PROGRESS_BAR_WIDTH, PROGRESS_BAR_HEIGHT};
-    SDL_RenderFillRect(renderer, &bgRect);
+    batch.fillRect(bgRect, {64, 64, 64, 255});
     
     // Calculate remaining time percentage
     float remainingTime = getRemainingTime();
@@ -58,25 +57,25 @@ void Booster::renderProgressBar(SDL_Renderer* renderer) {
     int progressWidth = static_cast<int>(PROGRESS_BAR_WIDTH * progress);
     
     // Draw progress bar (green to yellow to red based on remaining time)
+    SDL_Color barColor;
     if (progress > 0.5f) {
         // Green for more than 50% remaining
-        SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
+        barColor = {0, 255, 0, 255};
     } else if (progress > 0.25f) {
         // Yellow for 25-50% remaining
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
+        barColor = {255, 255, 0, 255};
     } else {
         // Red for less than 25% remaining
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+        barColor = {255, 0, 0, 255};
     }
     
     if (progressWidth > 0) {
         SDL_Rect progressRect = {barX, barY, progressWidth, PROGRESS_BAR_HEIGHT};
-        SDL_RenderFillRect(renderer, &progressRect);
+        batch.fillRect(progressRect, barColor);
     }
     
     // Draw border
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    SDL_RenderDrawRect(renderer, &bgRect);
+    batch.drawRect(bgRect, {255, 255, 255, 255});
 }
 
 void Booster::collect() {
@@ -8,7 +8,7 @@ public:
     Booster(const Vector2& spawnPosition, float maxLifetime);
     virtual ~Booster();
 
-    virtual void initialize(SDL_Renderer* renderer);
+    virtual void initialize();
     virtual void update(float deltaTime);
     virtual void render(SDL_Renderer* renderer);
     void renderProgressBar(SDL_Renderer* renderer);
@@ -1,11 +1,14 @@
 #include "BossEnemy.h"
-#include "Bullet.h"
-#include <SDL2/SDL_image.h>
+#include "Profiler.h"
+#include "BulletPool.h"
+#include "TextureCache.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
 #include <cmath>
 #include <iostream>
 
-BossEnemy::BossEnemy(Vector2 pos, SDL_Renderer* renderer)
-    : Enemy(pos, renderer), fireCooldown(1.5f), timeSinceLastShot(0.0f),
+BossEnemy::BossEnemy(Vector2 pos)
+    : Enemy(pos), fireCooldown(1.5f), timeSinceLastShot(0.0f),
       movementTimer(0.0f), isSprintPhase(false), bossTexture(nullptr), bossRushTexture(nullptr), facingRight(false), maxHealth(500) {
 
     
@@ -21,45 +24,24 @@ BossEnemy::BossEnemy(Vector2 pos, SDL_Renderer* renderer)
     spriteWidth = 200;      // Базовый 64 * 2 * 1.3 * 1.2 ≈ 200
     spriteHeight = 200;     // Базовый 64 * 2 * 1.3 * 1.2 ≈ 200
     
-    loadSprites(renderer);
+    loadSprites();
 }
 
 BossEnemy::~BossEnemy() {
-    if (bossRushTexture) {
-        SDL_DestroyTexture(bossRushTexture);
-        bossRushTexture = nullptr;
-    }
+    TextureCache& cache = TextureCache::instance();
+    cache.release(bossTexture);
+    cache.release(bossRushTexture);
 }
 
-void BossEnemy::loadSprites(SDL_Renderer* renderer) {
+void BossEnemy::loadSprites() {
+    TextureCache& cache = TextureCache::instance();
     // Загружаем обычный спрайт босса
-    SDL_Surface* surface = IMG_Load("assets/enemies/bossT.png");
-    if (!surface) {
-        std::cout << "Failed to load bossT.png: " << IMG_GetError() << std::endl;
-        bossTexture = nullptr;
-    } else {
-        bossTexture = SDL_CreateTextureFromSurface(renderer, surface);
-        SDL_FreeSurface(surface);
-        if (!bossTexture) {
-            std::cout << "Failed to create boss texture: " << SDL_GetError() << std::endl;
-        }
-    }
-    
+    bossTexture = cache.acquire("assets/enemies/bossT.png");
     // Загружаем спрайт босса для режима спринта
-    surface = IMG_Load("assets/enemies/bossT_rush.png");
-    if (!surface) {
-        std::cout << "Failed to load bossT_rush.png: " << IMG_GetError() << std::endl;
-        bossRushTexture = nullptr;
-    } else {
-        bossRushTexture = SDL_CreateTextureFromSurface(renderer, surface);
-        SDL_FreeSurface(surface);
-        if (!bossRushTexture) {
-            std::cout << "Failed to create boss rush texture: " << SDL_GetError() << std::endl;
-        }
-    }
+    bossRushTexture = cache.acquire("assets/enemies/bossT_rush.png");
 }
 
-void BossEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
+void BossEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) {
     timeSinceLastShot += deltaTime;
     if (timeSinceLastShot < fireCooldown) return;
     timeSinceLastShot = 0.0f;
@@ -72,7 +54,7 @@ void BossEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vector<
     
     // Босс стреляет быстрыми оранжевыми пулями
     // Скорость пули в 2 раза быстрее других врагов (обычно ~300, делаем 600)
-    bullets.push_back(std::make_unique<Bullet>(
+    bullets.spawn(
         position, 
         direction, 
         /*damage*/ 12, 
@@ -80,10 +62,11 @@ void BossEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vector<
         /*speed*/ 600.0f,  // В 2 раза быстрее
         BulletType::BOSS_BULLET,  // Специальный тип для оранжевого цвета
         /*enemyOwned*/ true
-    ));
+    );
 }
 
-void BossEnemy::update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
+void BossEnemy::update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) {
+    PROFILE_SCOPE("BossEnemy::update");
     // Двухфазное движение: 4 сек медленно + 2 сек спринт
     movementTimer += deltaTime;
     
@@ -125,8 +108,10 @@ void BossEnemy::update(float deltaTime, Vector2 playerPos, std::vector<std::uniq
     }
 }
 
-void BossEnemy::render(SDL_Renderer* renderer) {
+void BossEnemy::render(SDL_Renderer* renderer, float alpha) {
+    PROFILE_SCOPE("BossEnemy::render");
     if (!alive) return;
+    Vector2 drawPos = Vector2::lerp(previousPosition, position, alpha);
     
     // Выбираем спрайт в зависимости от фазы движения
     SDL_Texture* currentTexture = nullptr;
@@ -140,29 +125,22 @@ void BossEnemy::render(SDL_Renderer* renderer) {
         // Рендерим босса с увеличенным размером + отзеркаливание
         // Исходный спрайт 360x360, отображаем как 200x200
         SDL_Rect dst{
-            (int)(position.x - spriteWidth/2),
-            (int)(position.y - spriteHeight/2),
+            (int)(drawPos.x - spriteWidth/2),
+            (int)(drawPos.y - spriteHeight/2),
             spriteWidth,
             spriteHeight
         };
         
         // Отзеркаливание если игрок справа (босс смотрит вправо)
         SDL_RendererFlip flip = facingRight ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-        SDL_RenderCopyEx(renderer, currentTexture, nullptr, &dst, 0.0, nullptr, flip);
+        SpriteBatch::instance().copyEx(currentTexture, nullptr, dst, 0.0, flip);
     } else {
         // Fallback - большой темно-красный круг (увеличен на 56%)
-        SDL_SetRenderDrawColor(renderer, 150, 0, 0, 255);
-        int cx = (int)position.x;
-        int cy = (int)position.y;
+        int cx = (int)drawPos.x;
+        int cy = (int)drawPos.y;
         int r = (int)(radius * 1.56f); // Соответствует увеличенному размеру (1.3 * 1.2)
         
-        for (int x = -r; x <= r; ++x) {
-            for (int y = -r; y <= r; ++y) {
-                if (x*x + y*y <= r*r) {
-                    SDL_RenderDrawPoint(renderer, cx + x, cy + y);
-                }
-            }
-        }
+        PrimitiveCache::instance().drawCircle(cx, cy, r, { 150, 0, 0, 255 });
     }
 }
 
@@ -170,6 +148,6 @@ int BossEnemy::getMaxHealth() const {
     return maxHealth;
 }
 
-std::unique_ptr<Enemy> CreateBossEnemy(const Vector2& pos, SDL_Renderer* renderer) {
-    return std::make_unique<BossEnemy>(pos, renderer);
+std::unique_ptr<Enemy> CreateBossEnemy(const Vector2& pos) {
+    return std::make_unique<BossEnemy>(pos);
 }
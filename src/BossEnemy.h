@@ -4,23 +4,23 @@
 #include <memory>
 #include <vector>
 
-class Bullet;
+class BulletEmitter;
 
 class BossEnemy : public Enemy {
 public:
-    BossEnemy(Vector2 pos, SDL_Renderer* renderer);
+    explicit BossEnemy(Vector2 pos);
     ~BossEnemy() override;
     
-    void update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) override;
-    void render(SDL_Renderer* renderer) override;
+    void update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) override;
+    void render(SDL_Renderer* renderer, float alpha) override;
     int getMaxHealth() const override;
     bool isBossUnit() const override { return true; }
     bool isLeader() const override { return false; }
 
     
 private:
-    void loadSprites(SDL_Renderer* renderer);
-    void tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets);
+    void loadSprites();
+    void tryFireAtPlayer(float deltaTime, Vector2 playerPos, BulletEmitter& bullets);
     
     // Стрельба
     float fireCooldown;
@@ -42,4 +42,4 @@ private:
 };
 
 // Factory function
-std::unique_ptr<Enemy> CreateBossEnemy(const Vector2& pos, SDL_Renderer* renderer);
+std::unique_ptr<Enemy> CreateBossEnemy(const Vector2& pos);
@@ -1,88 +0,0 @@
-#include "Bullet.h"
-
-Bullet::Bullet(Vector2 pos, Vector2 dir, int dmg, float range, float speed, BulletType type, bool enemyOwnedFlag, SDL_Color color) 
-    : position(pos), startPosition(pos), direction(dir.normalized()), 
-      speed(speed), radius(7), maxRange(range), damage(dmg), alive(true), bulletType(type),
-      velocity(dir.normalized() * speed), gravity(550.0f), enemyOwned(enemyOwnedFlag), bulletColor(color) {
-}
-
-void Bullet::update(float deltaTime) {
-    if (bulletType == BulletType::ENEMY_LOB) {
-        // simple parabolic motion: integrate velocity with gravity downward
-        velocity.y += gravity * deltaTime;
-        position += velocity * deltaTime;
-    } else {
-        position += direction * speed * deltaTime;
-    }
-    
-    // Check if bullet is out of bounds
-    if (position.x < 0 || position.x > 1920 || position.y < 0 || position.y > 1080) {
-        alive = false;
-    }
-    
-    // Check if bullet has exceeded its range for non-lob; for lob, use bigger cap
-    float distanceTraveled = startPosition.distance(position);
-    float allowedRange = (bulletType == BulletType::ENEMY_LOB) ? maxRange * 1.5f : maxRange;
-    if (distanceTraveled > allowedRange) {
-        alive = false;
-    }
-}
-
-void Bullet::render(SDL_Renderer* renderer) {
-    if (!alive) return;
-    
-    // Color based on bullet type and ownership
-
-    switch (bulletType) {
-        case BulletType::BOSS_BULLET:
-            SDL_SetRenderDrawColor(renderer, 255, 140, 0, 255); // Orange for boss bullets
-            break;
-        case BulletType::MINIBOSS_1:
-            SDL_SetRenderDrawColor(renderer, 255, 60, 60, 255); // Red
-            break;
-        case BulletType::MINIBOSS_2:
-            SDL_SetRenderDrawColor(renderer, 60, 255, 60, 255); // Green
-            break;
-        case BulletType::MINIBOSS_3:
-            SDL_SetRenderDrawColor(renderer, 60, 120, 255, 255); // Blue
-            break;
-        case BulletType::MINIBOSS_4:
-            SDL_SetRenderDrawColor(renderer, 60, 255, 255, 255); // Cyan
-            break;
-        case BulletType::MINIBOSS_5:
-            SDL_SetRenderDrawColor(renderer, 200, 60, 255, 255); // Magenta
-            break;
-        case BulletType::FRACTAL_CENTER:
-            SDL_SetRenderDrawColor(renderer, 255, 100, 100, 255); // Red for fractal center
-            break;
-        case BulletType::FRACTAL_LEVEL1:
-            SDL_SetRenderDrawColor(renderer, 100, 255, 100, 255); // Green for fractal level 1
-            break;
-        case BulletType::FRACTAL_LEVEL2:
-            SDL_SetRenderDrawColor(renderer, 100, 100, 255, 255); // Blue for fractal level 2
-            break;
-        case BulletType::CENTIPEDE_BULLET:
-            SDL_SetRenderDrawColor(renderer, bulletColor.r, bulletColor.g, bulletColor.b, bulletColor.a); // Custom color for centipede bullets
-            break;        
-        default:
-            if (enemyOwned) {
-                SDL_SetRenderDrawColor(renderer, 255, 50, 50, 255); // Red for enemy bullets
-            } else {
-                SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // Yellow for player bullets
-            }
-            break;
-
-    }
-    
-    int centerX = (int)position.x;
-    int centerY = (int)position.y;
-    int r = (int)radius;
-    
-    for (int x = -r; x <= r; x++) {
-        for (int y = -r; y <= r; y++) {
-            if (x*x + y*y <= r*r) {
-                SDL_RenderDrawPoint(renderer, centerX + x, centerY + y);
-            }
-        }
-    }
-}
\ No newline at end of file
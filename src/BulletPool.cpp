@@ -0,0 +1,167 @@
+#include "BulletPool.h"
+#include "Profiler.h"
+#include "PrimitiveCache.h"
+#include <cstring>
+
+namespace {
+    const float ARENA_WIDTH = 1920.0f;
+    const float ARENA_HEIGHT = 1080.0f;
+    const float LOB_GRAVITY = 550.0f; // positive value pulls "down" on screen
+}
+
+BulletPool::BulletPool()
+    : posX(CAPACITY), posY(CAPACITY), velX(CAPACITY), velY(CAPACITY),
+      gravity(CAPACITY), startX(CAPACITY), startY(CAPACITY), maxRangeSq(CAPACITY),
+      alive(CAPACITY), prevX(CAPACITY), prevY(CAPACITY),
+      damage(CAPACITY), type(CAPACITY), enemyOwned(CAPACITY), color(CAPACITY) {
+}
+
+int BulletPool::spawn(Vector2 pos, Vector2 dir, int dmg, float range, float speed, BulletType bulletType, bool enemyOwnedFlag, SDL_Color bulletColor) {
+    if (count >= CAPACITY) {
+        dropped++;
+        return -1;
+    }
+
+    int i = count++;
+    Vector2 velocity = dir.normalized() * speed;
+    bool lob = (bulletType == BulletType::ENEMY_LOB);
+    // Lobbed shots arc, so they get a bigger range cap
+    float allowedRange = lob ? range * 1.5f : range;
+
+    posX[i] = prevX[i] = startX[i] = pos.x;
+    posY[i] = prevY[i] = startY[i] = pos.y;
+    velX[i] = velocity.x;
+    velY[i] = velocity.y;
+    gravity[i] = lob ? LOB_GRAVITY : 0.0f;
+    maxRangeSq[i] = allowedRange * allowedRange;
+    alive[i] = 1;
+    damage[i] = dmg;
+    type[i] = bulletType;
+    enemyOwned[i] = enemyOwnedFlag ? 1 : 0;
+    color[i] = bulletColor;
+    return i;
+}
+
+void BulletPool::updateRange(int begin, int end, float deltaTime) {
+    PROFILE_SCOPE("BulletPool::updateRange");
+    // Straight-line and lobbed bullets share one branch-free kernel: gravity is
+    // simply 0 for everything but ENEMY_LOB. Raw pointers keep the loop
+    // vectorisable without the compiler worrying about vector internals.
+    float* __restrict px = posX.data();
+    float* __restrict py = posY.data();
+    const float* __restrict vx = velX.data();
+    float* __restrict vy = velY.data();
+    const float* __restrict g = gravity.data();
+    const float* __restrict sx = startX.data();
+    const float* __restrict sy = startY.data();
+    const float* __restrict rangeSq = maxRangeSq.data();
+    uint8_t* __restrict live = alive.data();
+
+    for (int i = begin; i < end; ++i) {
+        vy[i] += g[i] * deltaTime;
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+
+        float dx = px[i] - sx[i];
+        float dy = py[i] - sy[i];
+        bool outOfBounds = (px[i] < 0.0f) | (px[i] > ARENA_WIDTH) | (py[i] < 0.0f) | (py[i] > ARENA_HEIGHT);
+        bool outOfRange = (dx * dx + dy * dy) > rangeSq[i];
+        live[i] &= (uint8_t)!(outOfBounds | outOfRange);
+    }
+}
+
+void BulletPool::moveSlot(int from, int to) {
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    velX[to] = velX[from];
+    velY[to] = velY[from];
+    gravity[to] = gravity[from];
+    startX[to] = startX[from];
+    startY[to] = startY[from];
+    maxRangeSq[to] = maxRangeSq[from];
+    alive[to] = alive[from];
+    prevX[to] = prevX[from];
+    prevY[to] = prevY[from];
+    damage[to] = damage[from];
+    type[to] = type[from];
+    enemyOwned[to] = enemyOwned[from];
+    color[to] = color[from];
+}
+
+void BulletPool::compact() {
+    int i = 0;
+    while (i < count) {
+        if (alive[i]) {
+            ++i;
+        } else {
+            // Fill the hole with the last bullet and re-check this slot
+            --count;
+            if (i != count) {
+                moveSlot(count, i);
+            }
+        }
+    }
+}
+
+void BulletPool::storePreviousPositions() {
+    std::memcpy(prevX.data(), posX.data(), count * sizeof(float));
+    std::memcpy(prevY.data(), posY.data(), count * sizeof(float));
+}
+
+SDL_Color BulletPool::colorFor(int index) const {
+    // Color based on bullet type and ownership
+    switch (type[index]) {
+        case BulletType::BOSS_BULLET:
+            return {255, 140, 0, 255}; // Orange for boss bullets
+        case BulletType::MINIBOSS_1:
+            return {255, 60, 60, 255}; // Red
+        case BulletType::MINIBOSS_2:
+            return {60, 255, 60, 255}; // Green
+        case BulletType::MINIBOSS_3:
+            return {60, 120, 255, 255}; // Blue
+        case BulletType::MINIBOSS_4:
+            return {60, 255, 255, 255}; // Cyan
+        case BulletType::MINIBOSS_5:
+            return {200, 60, 255, 255}; // Magenta
+        case BulletType::FRACTAL_CENTER:
+            return {255, 100, 100, 255}; // Red for fractal center
+        case BulletType::FRACTAL_LEVEL1:
+            return {100, 255, 100, 255}; // Green for fractal level 1
+        case BulletType::FRACTAL_LEVEL2:
+            return {100, 100, 255, 255}; // Blue for fractal level 2
+        case BulletType::CENTIPEDE_BULLET:
+            return color[index]; // Custom color for centipede bullets
+        default:
+            if (enemyOwned[index]) {
+                return {255, 50, 50, 255}; // Red for enemy bullets
+            }
+            return {255, 255, 0, 255}; // Yellow for player bullets
+    }
+}
+
+void BulletPool::renderAll(SDL_Renderer* /*renderer*/, float alpha) const {
+    PROFILE_SCOPE("BulletPool::renderAll");
+    PrimitiveCache& primitives = PrimitiveCache::instance();
+    int r = (int)RADIUS;
+
+    for (int i = 0; i < count; ++i) {
+        if (!alive[i]) continue;
+
+        int centerX = (int)(prevX[i] + (posX[i] - prevX[i]) * alpha);
+        int centerY = (int)(prevY[i] + (posY[i] - prevY[i]) * alpha);
+        primitives.drawCircle(centerX, centerY, r, colorFor(i));
+    }
+}
+
+int BulletCommandBuffer::spawn(Vector2 pos, Vector2 dir, int dmg, float range, float speed, BulletType bulletType, bool enemyOwnedFlag, SDL_Color bulletColor) {
+    commands.push_back({ pos, dir, dmg, range, speed, bulletType, enemyOwnedFlag, bulletColor });
+    return -1;
+}
+
+void BulletCommandBuffer::flushTo(BulletPool& pool) {
+    for (const Command& command : commands) {
+        pool.spawn(command.pos, command.dir, command.damage, command.range, command.speed,
+                   command.type, command.enemyOwned, command.color);
+    }
+    commands.clear();
+}
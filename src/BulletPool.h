@@ -0,0 +1,122 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+#include "Vector2.h"
+
+enum class BulletType {
+    PISTOL,
+    SMG,
+    ENEMY_LOB,
+    SHOTGUN,
+    SNIPER,
+    BOSS_BULLET,
+    MINIBOSS_1,
+    MINIBOSS_2,
+    MINIBOSS_3,
+    MINIBOSS_4,
+    MINIBOSS_5,
+    FRACTAL_CENTER,   // Красные пули центрального узла
+    FRACTAL_LEVEL1,   // Зеленые пули уровня 1
+    FRACTAL_LEVEL2,    // Синие пули уровня 2
+    CENTIPEDE_BULLET
+
+};
+
+// Where enemy updates put their shots. BulletPool spawns directly; a
+// BulletCommandBuffer records them so updates running on worker threads never
+// touch the shared pool, and the buffers are replayed into it afterwards.
+class BulletEmitter {
+public:
+    virtual ~BulletEmitter() = default;
+    virtual int spawn(Vector2 pos, Vector2 dir, int damage = 10, float range = 200.0f, float speed = 400.0f, BulletType type = BulletType::PISTOL, bool enemyOwned = false, SDL_Color color = {255, 255, 0, 255}) = 0;
+};
+
+// Every projectile in the game, stored as parallel arrays (structure of arrays).
+// Storage is allocated once for CAPACITY bullets, so spawn() never touches the
+// heap; dead bullets are swap-removed by compact(), which keeps the live ones
+// packed in [0, size()) for linear iteration. Indices are only stable between
+// two compact() calls.
+class BulletPool final : public BulletEmitter {
+public:
+    static const int CAPACITY = 32768;
+    static constexpr float RADIUS = 7.0f;
+
+    BulletPool();
+
+    // Same parameters the old Bullet constructor took. Returns the index, or -1 if the pool is full
+    int spawn(Vector2 pos, Vector2 dir, int damage = 10, float range = 200.0f, float speed = 400.0f, BulletType type = BulletType::PISTOL, bool enemyOwned = false, SDL_Color color = {255, 255, 0, 255}) override;
+
+    // Moves every bullet and kills the ones out of the arena or past their range
+    void updateAll(float deltaTime) { updateRange(0, count, deltaTime); }
+    // Same for [begin, end); disjoint ranges can run on different threads
+    void updateRange(int begin, int end, float deltaTime);
+    // Swap-removes dead bullets
+    void compact();
+    void clear() { count = 0; }
+
+    void storePreviousPositions();
+    void renderAll(SDL_Renderer* renderer, float alpha) const;
+
+    int size() const { return count; }
+    Vector2 getPosition(int index) const { return Vector2(posX[index], posY[index]); }
+    float getRadius() const { return RADIUS; }
+    int getDamage(int index) const { return damage[index]; }
+    bool isAlive(int index) const { return alive[index] != 0; }
+    void destroy(int index) { alive[index] = 0; }
+    bool isEnemyOwned(int index) const { return enemyOwned[index] != 0; }
+
+    // Shots refused because the pool was full (should stay 0)
+    int getDroppedCount() const { return dropped; }
+
+private:
+    void moveSlot(int from, int to);
+    SDL_Color colorFor(int index) const;
+
+    int count = 0;
+    int dropped = 0;
+
+    // Kinematics - everything updateAll() reads and writes
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> gravity;        // 0 except for ENEMY_LOB
+    std::vector<float> startX, startY;
+    std::vector<float> maxRangeSq;     // already includes the 1.5x lob allowance
+    std::vector<uint8_t> alive;
+
+    // Render interpolation
+    std::vector<float> prevX, prevY;
+
+    // Cold data, touched only by collisions and rendering
+    std::vector<int> damage;
+    std::vector<BulletType> type;
+    std::vector<uint8_t> enemyOwned;
+    std::vector<SDL_Color> color;
+};
+
+// Records spawn() calls instead of executing them. One buffer per job chunk;
+// flushing the buffers in chunk order gives the same pool contents as a serial
+// update, however the chunks were scheduled across threads.
+class BulletCommandBuffer final : public BulletEmitter {
+public:
+    // Always returns -1: the pool index is only known once the command is flushed
+    int spawn(Vector2 pos, Vector2 dir, int damage = 10, float range = 200.0f, float speed = 400.0f, BulletType type = BulletType::PISTOL, bool enemyOwned = false, SDL_Color color = {255, 255, 0, 255}) override;
+
+    // Spawns everything recorded into the pool, in recording order, and empties the buffer
+    void flushTo(BulletPool& pool);
+    bool empty() const { return commands.empty(); }
+
+private:
+    struct Command {
+        Vector2 pos;
+        Vector2 dir;
+        int damage;
+        float range;
+        float speed;
+        BulletType type;
+        bool enemyOwned;
+        SDL_Color color;
+    };
+
+    std::vector<Command> commands; // keeps its capacity between frames
+};
@@ -1,12 +1,17 @@
 #include "CentipedeEnemy.h"
-#include "Bullet.h"
-#include <SDL2/SDL_image.h>
+#include "Profiler.h"
+#include "BulletPool.h"
+#include "TextureCache.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
+#include "Random.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
-#include <random>
 
-CentipedeEnemy::CentipedeEnemy(Vector2 pos, SDL_Renderer* renderer)
-    : Enemy(pos, renderer), segmentTexture(nullptr), movementTimer(0.0f), 
+CentipedeEnemy::CentipedeEnemy(Vector2 pos)
+    : Enemy(pos), headSlot(0), headDirection(1, 0), bodyCenter(pos), bodyRadius(0.0f),
+      segmentTexture(nullptr), movementTimer(0.0f), 
       maxHealth(1000), segmentsLost(0) {
     
     // Характеристики многоножки
@@ -20,58 +25,63 @@ CentipedeEnemy::CentipedeEnemy(Vector2 pos, SDL_Renderer* renderer)
     spriteWidth = 64;   // 32 * 2 = 64
     spriteHeight = 64;  // 32 * 2 = 64
     
-    loadSegmentSprite(renderer);
+    loadSegmentSprite();
     initializeSegments();
 }
 
 CentipedeEnemy::~CentipedeEnemy() {
-    if (segmentTexture) {
-        SDL_DestroyTexture(segmentTexture);
-        segmentTexture = nullptr;
-    }
+    TextureCache::instance().release(segmentTexture);
 }
 
-void CentipedeEnemy::loadSegmentSprite(SDL_Renderer* renderer) {
-    SDL_Surface* surface = IMG_Load("assets/enemies/pebblin.png");
-    if (!surface) {
-        std::cout << "Failed to load pebblin.png for centipede segments: " << IMG_GetError() << std::endl;
-        segmentTexture = nullptr;
-    } else {
-        segmentTexture = SDL_CreateTextureFromSurface(renderer, surface);
-        SDL_FreeSurface(surface);
-        if (!segmentTexture) {
-            std::cout << "Failed to create segment texture: " << SDL_GetError() << std::endl;
-        }
-    }
+void CentipedeEnemy::loadSegmentSprite() {
+    segmentTexture = TextureCache::instance().acquire("assets/enemies/pebblin.png");
 }
 
 void CentipedeEnemy::initializeSegments() {
     segments.clear();
     segments.reserve(INITIAL_SEGMENTS);
-    
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    positions.assign(INITIAL_SEGMENTS, Vector2(0, 0));
+    headSlot = 0;
+    headDirection = Vector2(1, 0);  // Начальное направление - вправо
     
     // Создаем сегменты вертикально вниз от начальной позиции
     for (int i = 0; i < INITIAL_SEGMENTS; ++i) {
+        positions[i] = Vector2(position.x, position.y + i * SEGMENT_SPACING);
+        
         CentipedeSegment segment;
-        segment.position = Vector2(position.x, position.y + i * SEGMENT_SPACING);
-        segment.direction = Vector2(1, 0);  // Начальное направление - вправо
         segment.timeSinceLastShot = static_cast<float>(i) * 0.3f;  // Разные интервалы стрельбы
+        segment.fireCooldown = rollFireCooldown();
         segment.bulletColor = generateRandomBulletColor();
-        segment.isHead = (i == 0);  // Первый сегмент - голова
         segments.push_back(segment);
     }
     
     // Обновляем позицию врага на позицию головы
-    position = segments[0].position;
+    position = segmentPosition(0);
+    updateBodyBounds();
 }
 
-SDL_Color CentipedeEnemy::generateRandomBulletColor() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 5);
+float CentipedeEnemy::rollFireCooldown() {
+    return BASE_FIRE_COOLDOWN + rng(RandomStream::BOSS).nextFloat();  // 2.0-3.0 секунд
+}
+
+void CentipedeEnemy::updateBodyBounds() {
+    int count = static_cast<int>(segments.size());
+    if (count == 0) return;
+    
+    Vector2 sum(0, 0);
+    for (int i = 0; i < count; ++i) {
+        sum += segmentPosition(i);
+    }
+    bodyCenter = sum * (1.0f / count);
     
+    float maxDistance = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        maxDistance = std::max(maxDistance, segmentPosition(i).distance(bodyCenter) + segmentRadius(i));
+    }
+    bodyRadius = maxDistance;
+}
+
+SDL_Color CentipedeEnemy::generateRandomBulletColor() {
     // Набор ярких цветов для пуль
     SDL_Color colors[] = {
         {255, 100, 100, 255},  // Красный
@@ -82,7 +92,7 @@ SDL_Color CentipedeEnemy::generateRandomBulletColor() {
         {100, 255, 255, 255}   // Голубой
     };
     
-    return colors[dis(gen)];
+    return colors[rng(RandomStream::VISUAL).rangeInt(0, 5)];
 }
 
 Vector2 CentipedeEnemy::getNextDirection(Vector2 currentPos, Vector2 targetPos) {
@@ -110,46 +120,42 @@ void CentipedeEnemy::updateMovement(float deltaTime, Vector2 playerPos) {
         movementTimer = 0.0f;
         
         if (!segments.empty()) {
-            // Сохраняем предыдущие позиции для змейкового движения
-            std::vector<Vector2> prevPositions;
-            for (const auto& segment : segments) {
-                prevPositions.push_back(segment.position);
-            }
-            
             // Двигаем голову к игроку
-            Vector2 headDirection = getNextDirection(segments[0].position, playerPos);
-            segments[0].direction = headDirection;
-            segments[0].position += headDirection * SEGMENT_SPACING;
+            Vector2 oldHead = segmentPosition(0);
+            headDirection = getNextDirection(oldHead, playerPos);
             
-            // Остальные сегменты следуют за предыдущими
-            for (size_t i = 1; i < segments.size(); ++i) {
-                segments[i].position = prevPositions[i - 1];
-            }
+            // Остальные сегменты следуют за предыдущими: head moves one slot back in
+            // the ring, so every segment i now reads the old position of segment i - 1
+            int capacity = static_cast<int>(positions.size());
+            headSlot = (headSlot + capacity - 1) % capacity;
+            positions[headSlot] = oldHead + headDirection * SEGMENT_SPACING;
             
             // Обновляем позицию врага на позицию головы
-            position = segments[0].position;
+            position = positions[headSlot];
+            updateBodyBounds();
         }
     }
 }
 
-void CentipedeEnemy::updateShooting(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
-    for (auto& segment : segments) {
+void CentipedeEnemy::updateShooting(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) {
+    for (size_t i = 0; i < segments.size(); ++i) {
+        CentipedeSegment& segment = segments[i];
         segment.timeSinceLastShot += deltaTime;
         
         // Каждый сегмент стреляет с разными интервалами
-        float fireCooldown = BASE_FIRE_COOLDOWN + (static_cast<float>(rand() % 1000) / 1000.0f);  // 2.0-3.0 секунд
-        
-        if (segment.timeSinceLastShot >= fireCooldown) {
+        if (segment.timeSinceLastShot >= segment.fireCooldown) {
             segment.timeSinceLastShot = 0.0f;
+            segment.fireCooldown = rollFireCooldown();
             
             // Направление к игроку
-            Vector2 toPlayer = playerPos - segment.position;
+            Vector2 segmentPos = segmentPosition(static_cast<int>(i));
+            Vector2 toPlayer = playerPos - segmentPos;
             if (toPlayer.length() > 1.0f) {
                 Vector2 direction = toPlayer.normalized();
                 
                 // Создаем цветную пулю под цвет сегмента
-                auto bullet = std::make_unique<Bullet>(
-                    segment.position,
+                bullets.spawn(
+                    segmentPos,
                     direction,
                     /*damage*/ 10,
                     /*range*/ 500.0f,
@@ -158,8 +164,6 @@ void CentipedeEnemy::updateShooting(float deltaTime, Vector2 playerPos, std::vec
                     /*enemyOwned*/ true,
                     segment.bulletColor  // Цвет пули соответствует цвету сегмента
                 );
-                
-                bullets.push_back(std::move(bullet));
             }
         }
     }
@@ -176,7 +180,8 @@ void CentipedeEnemy::removeSegment() {
     }
 }
 
-void CentipedeEnemy::update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
+void CentipedeEnemy::update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) {
+    PROFILE_SCOPE("CentipedeEnemy::update");
     if (!alive) return;
     
     updateMovement(deltaTime, playerPos);
@@ -197,57 +202,43 @@ void CentipedeEnemy::update(float deltaTime, Vector2 playerPos, std::vector<std:
     }
 }
 
-void CentipedeEnemy::render(SDL_Renderer* renderer) {
+void CentipedeEnemy::render(SDL_Renderer* renderer, float /*alpha*/) {
+    PROFILE_SCOPE("CentipedeEnemy::render");
     if (!alive) return;
+    // Segments move in discrete steps on a timer, so they are drawn where they are
     
     // Рендерим все сегменты
     for (size_t i = 0; i < segments.size(); ++i) {
         const auto& segment = segments[i];
+        Vector2 segmentPos = segmentPosition(static_cast<int>(i));
+        bool isHead = (i == 0);
         
         if (segmentTexture) {
             SDL_Rect dst{
-                (int)(segment.position.x - spriteWidth/2),
-                (int)(segment.position.y - spriteHeight/2),
+                (int)(segmentPos.x - spriteWidth/2),
+                (int)(segmentPos.y - spriteHeight/2),
                 spriteWidth,
                 spriteHeight
             };
             
             // Голова немного больше остальных сегментов
-            if (segment.isHead) {
+            if (isHead) {
                 dst.w = (int)(spriteWidth * 1.3f);
                 dst.h = (int)(spriteHeight * 1.3f);
-                dst.x = (int)(segment.position.x - dst.w/2);
-                dst.y = (int)(segment.position.y - dst.h/2);
+                dst.x = (int)(segmentPos.x - dst.w/2);
+                dst.y = (int)(segmentPos.y - dst.h/2);
             }
             
-            // Меняем цвет текстуры в зависимости от сегмента
-            SDL_SetTextureColorMod(segmentTexture, 
-                                   segment.bulletColor.r, 
-                                   segment.bulletColor.g, 
-                                   segment.bulletColor.b);
-            
-            SDL_RenderCopy(renderer, segmentTexture, nullptr, &dst);
-            
-            // Сбрасываем цветовую модуляцию
-            SDL_SetTextureColorMod(segmentTexture, 255, 255, 255);
+            // Меняем цвет текстуры в зависимости от сегмента (через цвет вершин батча)
+            SpriteBatch::instance().copy(segmentTexture, nullptr, dst,
+                                         { segment.bulletColor.r, segment.bulletColor.g, segment.bulletColor.b, 255 });
         } else {
             // Fallback - цветные круги
-            SDL_SetRenderDrawColor(renderer, 
-                                   segment.bulletColor.r, 
-                                   segment.bulletColor.g, 
-                                   segment.bulletColor.b, 255);
-            
-            int cx = (int)segment.position.x;
-            int cy = (int)segment.position.y;
-            int r = segment.isHead ? (int)(radius * 1.3f) : (int)radius;
+            int cx = (int)segmentPos.x;
+            int cy = (int)segmentPos.y;
+            int r = (int)segmentRadius(static_cast<int>(i));
             
-            for (int x = -r; x <= r; ++x) {
-                for (int y = -r; y <= r; ++y) {
-                    if (x*x + y*y <= r*r) {
-                        SDL_RenderDrawPoint(renderer, cx + x, cy + y);
-                    }
-                }
-            }
+            PrimitiveCache::instance().drawCircle(cx, cy, r, { segment.bulletColor.r, segment.bulletColor.g, segment.bulletColor.b, 255 });
         }
     }
 }
@@ -272,10 +263,30 @@ void CentipedeEnemy::takeDamage(int damage) {
     hit();
 }
 
+bool CentipedeEnemy::takeDamageAt(Vector2 point, float hitRadius, int damage) {
+    if (!alive) return false;
+    
+    float bodyReach = bodyRadius + hitRadius;
+    Vector2 toBody = point - bodyCenter;
+    if (toBody.x * toBody.x + toBody.y * toBody.y > bodyReach * bodyReach) {
+        return false;
+    }
+    
+    for (int i = 0; i < static_cast<int>(segments.size()); ++i) {
+        Vector2 offset = point - segmentPosition(i);
+        float reach = segmentRadius(i) + hitRadius;
+        if (offset.x * offset.x + offset.y * offset.y < reach * reach) {
+            takeDamage(damage);
+            return true;
+        }
+    }
+    return false;
+}
+
 int CentipedeEnemy::getMaxHealth() const {
     return maxHealth;
 }
 
-std::unique_ptr<Enemy> CreateCentipedeEnemy(const Vector2& pos, SDL_Renderer* renderer) {
-    return std::make_unique<CentipedeEnemy>(pos, renderer);
+std::unique_ptr<Enemy> CreateCentipedeEnemy(const Vector2& pos) {
+    return std::make_unique<CentipedeEnemy>(pos);
 }
@@ -4,34 +4,42 @@
 #include <memory>
 #include <vector>
 
-class Bullet;
+class BulletEmitter;
 
+// Per-segment state that stays with the segment; positions live in the ring buffer
 struct CentipedeSegment {
-    Vector2 position;
-    Vector2 direction;  // Направление движения для дискретного движения
     float timeSinceLastShot;
+    float fireCooldown;     // Выпадает заранее, перебрасывается после каждого выстрела
     SDL_Color bulletColor;  // Цвет пули для этого звена
-    bool isHead;  // Является ли звено головой
 };
 
 class CentipedeEnemy : public Enemy {
 public:
-    CentipedeEnemy(Vector2 pos, SDL_Renderer* renderer);
+    explicit CentipedeEnemy(Vector2 pos);
     ~CentipedeEnemy() override;
     
-    void update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) override;
-    void render(SDL_Renderer* renderer) override;
+    void update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) override;
+    void render(SDL_Renderer* renderer, float alpha) override;
     int getMaxHealth() const override;
     void takeDamage(int damage) override;
+    // Hits any segment, not just the head
+    bool takeDamageAt(Vector2 point, float hitRadius, int damage) override;
     
 private:
-    void loadSegmentSprite(SDL_Renderer* renderer);
+    void loadSegmentSprite();
     void initializeSegments();
     void updateMovement(float deltaTime, Vector2 playerPos);
-    void updateShooting(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets);
+    void updateShooting(float deltaTime, Vector2 playerPos, BulletEmitter& bullets);
     void removeSegment();
     Vector2 getNextDirection(Vector2 currentPos, Vector2 targetPos);
     SDL_Color generateRandomBulletColor();
+    float rollFireCooldown();
+    // Segment 0 is the head; the ring is walked backwards so a step is one head write
+    Vector2 segmentPosition(int segment) const {
+        return positions[(headSlot + segment) % positions.size()];
+    }
+    float segmentRadius(int segment) const { return segment == 0 ? radius * 1.3f : radius; }
+    void updateBodyBounds();
     
     // Константы
     static constexpr int INITIAL_SEGMENTS = 10;
@@ -40,8 +48,15 @@ private:
     static constexpr float MOVEMENT_TIMER = 0.4f;    // Еще быстрее движение
     static constexpr float BASE_FIRE_COOLDOWN = 2.0f;
     
-    // Данные сегментов
+    // Данные сегментов: segments[i] is body segment i (0 = head), the tail is popped on damage
     std::vector<CentipedeSegment> segments;
+    // Ring buffer of segment positions, sized for the full body once at spawn
+    std::vector<Vector2> positions;
+    int headSlot;
+    Vector2 headDirection;
+    // Circle around the whole body, refreshed every step, to reject bullets early
+    Vector2 bodyCenter;
+    float bodyRadius;
     SDL_Texture* segmentTexture;
     
     // Движение змейки
@@ -54,4 +69,4 @@ private:
 };
 
 // Factory function
-std::unique_ptr<Enemy> CreateCentipedeEnemy(const Vector2& pos, SDL_Renderer* renderer);
+std::unique_ptr<Enemy> CreateCentipedeEnemy(const Vector2& pos);
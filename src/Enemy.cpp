@@ -1,53 +1,40 @@
 #include "Enemy.h"
+#include "Profiler.h"
 #include <cstdlib>
 #include <iostream>
 #include <vector>
 #include <memory>
-#include "Bullet.h"
+#include "BulletPool.h"
+#include "TextureCache.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
 
-Enemy::Enemy(Vector2 pos, SDL_Renderer* renderer) 
-    : position(pos), velocity(0, 0), radius(30), speed(80), 
+Enemy::Enemy(Vector2 pos) 
+    : position(pos), previousPosition(pos), velocity(0, 0), radius(30), speed(80), 
       health(1), damage(10), alive(true), state(EnemyState::IDLE),
       animationTimer(0.0f), hitTimer(0.0f), currentFrame(0),
       idleFrame1(nullptr), idleFrame2(nullptr), hitFrame(nullptr),
       spriteWidth(64), spriteHeight(64) {
-    loadSprites(renderer);
+    loadSprites();
 }
 
 Enemy::~Enemy() {
-    if (idleFrame1) SDL_DestroyTexture(idleFrame1);
-    if (idleFrame2) SDL_DestroyTexture(idleFrame2);
-    if (hitFrame) SDL_DestroyTexture(hitFrame);
+    // Textures are shared through the cache - drop our references only
+    TextureCache& cache = TextureCache::instance();
+    cache.release(idleFrame1);
+    cache.release(idleFrame2);
+    cache.release(hitFrame);
 }
 
-void Enemy::loadSprites(SDL_Renderer* renderer) {
-    idleFrame1 = loadTexture("monsters/landmonster/Transparent PNG/idle/frame-1.png", renderer);
-    idleFrame2 = loadTexture("monsters/landmonster/Transparent PNG/idle/frame-2.png", renderer);
-    hitFrame = loadTexture("monsters/landmonster/Transparent PNG/got hit/frame.png", renderer);
-    
-    if (!idleFrame1 || !idleFrame2 || !hitFrame) {
-        std::cout << "Warning: Could not load some monster sprites!" << std::endl;
-    }
+void Enemy::loadSprites() {
+    TextureCache& cache = TextureCache::instance();
+    idleFrame1 = cache.acquire("monsters/landmonster/Transparent PNG/idle/frame-1.png");
+    idleFrame2 = cache.acquire("monsters/landmonster/Transparent PNG/idle/frame-2.png");
+    hitFrame = cache.acquire("monsters/landmonster/Transparent PNG/got hit/frame.png");
 }
 
-SDL_Texture* Enemy::loadTexture(const char* path, SDL_Renderer* renderer) {
-    SDL_Surface* surface = IMG_Load(path);
-    if (!surface) {
-        std::cout << "Unable to load image " << path << "! SDL_image Error: " << IMG_GetError() << std::endl;
-        return nullptr;
-    }
-    
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    
-    if (!texture) {
-        std::cout << "Unable to create texture from " << path << "! SDL Error: " << SDL_GetError() << std::endl;
-    }
-    
-    return texture;
-}
-
-void Enemy::update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& /*bullets*/) {
+void Enemy::update(float deltaTime, Vector2 playerPos, BulletEmitter& /*bullets*/) {
+    PROFILE_SCOPE("Enemy::update");
     Vector2 direction = (playerPos - position).normalized();
     velocity = direction * speed;
     position += velocity * deltaTime;
@@ -71,8 +58,10 @@ void Enemy::update(float deltaTime, Vector2 playerPos, std::vector<std::unique_p
     }
 }
 
-void Enemy::render(SDL_Renderer* renderer) {
+void Enemy::render(SDL_Renderer* renderer, float alpha) {
+    PROFILE_SCOPE("Enemy::render");
     if (!alive) return;
+    Vector2 drawPos = Vector2::lerp(previousPosition, position, alpha);
     
     SDL_Texture* currentTexture = nullptr;
     
@@ -86,27 +75,19 @@ void Enemy::render(SDL_Renderer* renderer) {
     // If we have a texture, render it; otherwise fall back to circle
     if (currentTexture) {
         SDL_Rect destRect = {
-            (int)(position.x - spriteWidth/2),
-            (int)(position.y - spriteHeight/2),
+            (int)(drawPos.x - spriteWidth/2),
+            (int)(drawPos.y - spriteHeight/2),
             spriteWidth,
             spriteHeight
         };
-        SDL_RenderCopy(renderer, currentTexture, nullptr, &destRect);
+        SpriteBatch::instance().copy(currentTexture, nullptr, destRect);
     } else {
         // Fallback to original circle rendering
-        SDL_SetRenderDrawColor(renderer, 255, 50, 50, 255);
-        
-        int centerX = (int)position.x;
-        int centerY = (int)position.y;
+        int centerX = (int)drawPos.x;
+        int centerY = (int)drawPos.y;
         int r = (int)radius;
         
-        for (int x = -r; x <= r; x++) {
-            for (int y = -r; y <= r; y++) {
-                if (x*x + y*y <= r*r) {
-                    SDL_RenderDrawPoint(renderer, centerX + x, centerY + y);
-                }
-            }
-        }
+        PrimitiveCache::instance().drawCircle(centerX, centerY, r, { 255, 50, 50, 255 });
     }
 }
 
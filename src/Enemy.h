@@ -10,17 +10,22 @@ enum class EnemyState {
     HIT
 };
 
-class Bullet;
+class BulletEmitter;
 
 class Enemy {
 public:
-    Enemy(Vector2 pos, SDL_Renderer* renderer);
+    explicit Enemy(Vector2 pos);
     virtual ~Enemy();
     
-    virtual void update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets);
-    virtual void render(SDL_Renderer* renderer);
+    virtual void update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets);
+    // alpha blends previousPosition -> position (0..1 between two fixed ticks)
+    virtual void render(SDL_Renderer* renderer, float alpha);
+    // The renderer lost its render target contents (deviceLost: every texture);
+    // enemies that cache drawing in a target redraw or recreate it
+    virtual void onRenderTargetsReset(bool /*deviceLost*/) {}
     
     Vector2 getPosition() const { return position; }
+    void storePreviousPosition() { previousPosition = position; }
     float getRadius() const { return radius; }
     bool isAlive() const { return alive; }
     void destroy() { alive = false; }
@@ -38,6 +43,18 @@ public:
         hit();
     }
     
+    // Position-aware damage: applies damage if a hit circle at point overlaps the
+    // body and returns whether it landed. Multi-part enemies hit the part struck.
+    virtual bool takeDamageAt(Vector2 point, float hitRadius, int damage) {
+        Vector2 offset = point - position;
+        float reach = radius + hitRadius;
+        if (offset.x * offset.x + offset.y * offset.y >= reach * reach) {
+            return false;
+        }
+        takeDamage(damage);
+        return true;
+    }
+    
     int getDamage() const { return damage; }
     int getHealth() const { return health; }
     virtual int getMaxHealth() const; // Виртуальный метод для получения максимального здоровья
@@ -49,11 +66,11 @@ public:
 
     
 private:
-    void loadSprites(SDL_Renderer* renderer);
-    SDL_Texture* loadTexture(const char* path, SDL_Renderer* renderer);
+    void loadSprites();
     
 protected:
     Vector2 position;
+    Vector2 previousPosition; // position at the start of the current tick, for render interpolation
     Vector2 velocity;
     float radius;
     float speed;
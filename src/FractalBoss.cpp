@@ -1,13 +1,16 @@
 #include "FractalBoss.h"
-#include "Bullet.h"
+#include "Profiler.h"
+#include "BulletPool.h"
+#include "Random.h"
+#include "Logger.h"
+#include "SpriteBatch.h"
+#include <algorithm>
 #include <cmath>
-#include <iostream>
 #include <limits>
-#include <random>
 #include <vector>
 
-FractalBoss::FractalBoss(Vector2 pos, SDL_Renderer* renderer)
-    : Enemy(pos, renderer), rotationSpeed(0.785f), currentRotation(0.0f),
+FractalBoss::FractalBoss(Vector2 pos)
+    : Enemy(pos), rotationSpeed(0.785f), currentRotation(0.0f),
       fractalDepth(2), baseSize(300.0f), totalNodes(0), maxHealth(0) {
     
     // Характеристики фрактального босса
@@ -19,47 +22,129 @@ FractalBoss::FractalBoss(Vector2 pos, SDL_Renderer* renderer)
     initializeFractal();
     
     // Подсчитываем общее здоровье и количество узлов
-    totalNodes = rootNode.countLivingNodes();
-    maxHealth = rootNode.getTotalHealth();
+    totalNodes = static_cast<int>(nodes.size());
+    maxHealth = 0;
+    for (const auto& node : nodes) {
+        maxHealth += node.maxHealth;
+    }
     health = maxHealth;
     
-    std::cout << "FractalBoss created with " << totalNodes << " nodes and " << maxHealth << " total health" << std::endl;
+    livingNodes.resize(totalNodes);
+    livingSlot.resize(totalNodes);
+    for (int i = 0; i < totalNodes; ++i) {
+        livingNodes[i] = i;
+        livingSlot[i] = i;
+    }
+    
+    computeBounds();
+    hitStack.reserve(totalNodes);
+    updateTransforms();
+    
+    LOG_INFO(LogCategory::SPAWN, "FractalBoss created with %d nodes and %d total health", totalNodes, maxHealth);
 }
 
 FractalBoss::~FractalBoss() {
-    // Автоматическая очистка FractalNode деструктором
+    if (silhouette) {
+        SDL_DestroyTexture(silhouette);
+    }
 }
 
 void FractalBoss::initializeFractal() {
-    // Инициализируем корневой узел с ограниченным здоровьем
-    rootNode = FractalNode(Vector2(0, 0), 100, 0); // Центральный узел: 100 HP
+    // 1 + 4 + 16 + ... узлов
+    int expectedNodes = 0;
+    for (int level = 0, count = 1; level <= fractalDepth; ++level, count *= 4) {
+        expectedNodes += count;
+    }
+    nodes.clear();
+    nodes.reserve(expectedNodes);
     
-    // Генерируем фрактальную структуру
-    generateFractal(rootNode, fractalDepth, baseSize);
+    // Per-node build state, indexed like nodes
+    std::vector<int> depthLeft;
+    std::vector<float> sizes;
+    depthLeft.reserve(expectedNodes);
+    sizes.reserve(expectedNodes);
+    
+    // Центральный узел: 100 HP
+    nodes.emplace_back(Vector2(0, 0), 100, 0, -1);
+    depthLeft.push_back(fractalDepth);
+    sizes.push_back(baseSize);
+    
+    // Breadth-first, so every level is contiguous and parents precede children
+    for (int i = 0; i < static_cast<int>(nodes.size()); ++i) {
+        int currentDepth = depthLeft[i];
+        if (currentDepth <= 0) continue;
+        
+        // Создаем 4 дочерних узла в углах квадрата
+        float offset = sizes[i] / 3.0f; // Расстояние от центра до угла
+        // currentDepth 2 = level 1: 80 HP, currentDepth 1 = level 2: 60 HP
+        int nodeHealth = 40 + currentDepth * 20;
+        int level = 4 - currentDepth;
+        const Vector2 corners[4] = {
+            Vector2(-offset, -offset), // Верх-лево
+            Vector2(offset, -offset),  // Верх-право
+            Vector2(-offset, offset),  // Низ-лево
+            Vector2(offset, offset)    // Низ-право
+        };
+        
+        nodes[i].firstChild = static_cast<int>(nodes.size());
+        nodes[i].childCount = 4;
+        for (const Vector2& corner : corners) {
+            nodes.emplace_back(corner, nodeHealth, level, i);
+            depthLeft.push_back(currentDepth - 1);
+            sizes.push_back(sizes[i] * 0.5f);
+        }
+    }
 }
 
-void FractalBoss::generateFractal(FractalNode& node, int currentDepth, float size) {
-    if (currentDepth <= 0) return;
-    
-    // Создаем 4 дочерних узла в углах квадрата
-    float offset = size / 3.0f; // Расстояние от центра до угла
-    node.children.resize(4);
+void FractalBoss::computeBounds() {
+    // Offsets are rigid under rotation, so subtree bounds are computed once,
+    // children first (reverse level order)
+    for (int i = static_cast<int>(nodes.size()) - 1; i >= 0; --i) {
+        FractalNode& node = nodes[i];
+        // Узел рисуется квадратом со стороной 2 * nodeRadius
+        float bounds = node.nodeRadius * 1.41421356f;
+        for (int c = node.firstChild; c >= 0 && c < node.firstChild + node.childCount; ++c) {
+            bounds = std::max(bounds, nodes[c].localOffset.length() + nodes[c].boundsRadius);
+        }
+        node.boundsRadius = bounds;
+    }
     
-    // Позиции углов квадрата с ограниченным здоровьем  
-    // currentDepth 2 = level 1: 80 HP, currentDepth 1 = level 2: 60 HP
-    int nodeHealth = 40 + currentDepth * 20; // 60, 80 HP в зависимости от глубины
-    node.children[0] = FractalNode(Vector2(-offset, -offset), nodeHealth, 4 - currentDepth); // Верх-лево
-    node.children[1] = FractalNode(Vector2(offset, -offset), nodeHealth, 4 - currentDepth);  // Верх-право
-    node.children[2] = FractalNode(Vector2(-offset, offset), nodeHealth, 4 - currentDepth);  // Низ-лево
-    node.children[3] = FractalNode(Vector2(offset, offset), nodeHealth, 4 - currentDepth);   // Низ-право
+    // Parents first, for the silhouette layout
+    for (auto& node : nodes) {
+        node.rootOffset = node.parent < 0 ? Vector2(0, 0) : nodes[node.parent].rootOffset + node.localOffset;
+    }
+    // Square texture holding the whole structure at any rotation, plus a margin for outlines
+    silhouetteSize = nodes.empty() ? 0 : (int)std::ceil(nodes[0].boundsRadius * 2.0f) + 4;
+}
+
+void FractalBoss::updateTransforms() {
+    // Один поворот на весь кадр
+    float cosR = std::cos(currentRotation);
+    float sinR = std::sin(currentRotation);
     
-    // Рекурсивно создаем подструктуры
-    for (auto& child : node.children) {
-        generateFractal(child, currentDepth - 1, size * 0.5f);
+    for (auto& node : nodes) {
+        Vector2 rotatedOffset(
+            node.localOffset.x * cosR - node.localOffset.y * sinR,
+            node.localOffset.x * sinR + node.localOffset.y * cosR
+        );
+        bool wasActive = node.active;
+        if (node.parent < 0) {
+            node.worldPosition = position + rotatedOffset;
+            node.active = node.alive;
+        } else {
+            const FractalNode& parent = nodes[node.parent];
+            node.worldPosition = parent.worldPosition + rotatedOffset;
+            // Узлы под уничтоженным родителем не стреляют и не рисуются
+            node.active = node.alive && parent.active;
+        }
+        if (node.active != wasActive) {
+            silhouetteDirty = true;
+        }
     }
 }
 
-void FractalBoss::update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
+void FractalBoss::update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) {
+    PROFILE_SCOPE("FractalBoss::update");
     if (!alive) return;
     
     // Медленное движение к игроку
@@ -69,23 +154,20 @@ void FractalBoss::update(float deltaTime, Vector2 playerPos, std::vector<std::un
     
     // Постоянное вращение структуры
     updateRotation(deltaTime);
+    updateTransforms();
     
     // Обновление всех узлов фрактала
-    rootNode.update(deltaTime, position, currentRotation, playerPos, bullets);
-    
-    // Обновление здоровья босса на основе живых узлов
-    updateHealthFromNodes();
+    for (auto& node : nodes) {
+        if (!node.active) continue;
+        node.shootTimer += deltaTime;
+        node.tryShoot(playerPos, bullets);
+    }
     
     // Проверка на смерть босса - только когда ВСЕ узлы уничтожены
-    int livingNodes = rootNode.countLivingNodes();
-    if (livingNodes == 0) {
+    if (livingNodes.empty()) {
         alive = false;
         health = 0;
-        std::cout << "FractalBoss defeated! All nodes destroyed!" << std::endl;
-    } else if (health <= 0 && livingNodes > 0) {
-        // Если здоровье 0, но узлы еще живы - восстанавливаем здоровье
-        health = rootNode.getTotalHealth();
-        std::cout << "Boss health restored: " << health << " (living nodes: " << livingNodes << ")" << std::endl;
+        LOG_INFO(LogCategory::COMBAT, "FractalBoss defeated! All nodes destroyed!");
     }
 }
 
@@ -98,84 +180,214 @@ void FractalBoss::updateRotation(float deltaTime) {
     }
 }
 
-void FractalBoss::render(SDL_Renderer* renderer) {
+void FractalBoss::render(SDL_Renderer* renderer, float alpha) {
+    PROFILE_SCOPE("FractalBoss::render");
     if (!alive) return;
+    Vector2 drawPos = Vector2::lerp(previousPosition, position, alpha);
+    
+    if (!silhouette && !silhouetteUnsupported) {
+        if (SDL_RenderTargetSupported(renderer)) {
+            silhouette = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                           silhouetteSize, silhouetteSize);
+        }
+        if (silhouette) {
+            SDL_SetTextureBlendMode(silhouette, SDL_BLENDMODE_BLEND);
+            silhouetteDirty = true;
+        } else {
+            LOG_WARN(LogCategory::ASSETS, "FractalBoss: no render target, drawing nodes every frame");
+            silhouetteUnsupported = true;
+        }
+    }
+    
+    if (!silhouette) {
+        // Transforms are from the last update; shift them to the interpolated position
+        drawStructure(drawPos - position, false);
+        return;
+    }
+    
+    if (silhouetteDirty) {
+        redrawSilhouette(renderer);
+    }
+    SDL_Rect dst = {
+        (int)(drawPos.x - silhouetteSize / 2),
+        (int)(drawPos.y - silhouetteSize / 2),
+        silhouetteSize,
+        silhouetteSize
+    };
+    SpriteBatch::instance().copyEx(silhouette, nullptr, dst, currentRotation * 180.0 / M_PI, SDL_FLIP_NONE);
+}
+
+void FractalBoss::onRenderTargetsReset(bool deviceLost) {
+    if (deviceLost && silhouette) {
+        // Recreated by the next render()
+        SDL_DestroyTexture(silhouette);
+        silhouette = nullptr;
+    }
+    silhouetteDirty = true;
+}
+
+void FractalBoss::redrawSilhouette(SDL_Renderer* renderer) {
+    PROFILE_SCOPE("FractalBoss::redrawSilhouette");
+    // Called mid-pass; draw straight into the texture without disturbing the queued world
+    SpriteBatch& batch = SpriteBatch::instance();
+    bool wasBatching = batch.pause();
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, silhouette);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    
+    float center = silhouetteSize * 0.5f;
+    drawStructure(Vector2(center, center), true);
+    
+    SDL_SetRenderTarget(renderer, previousTarget);
+    batch.resume(wasBatching);
+    silhouetteDirty = false;
+}
+
+void FractalBoss::drawStructure(Vector2 origin, bool cached) const {
+    SpriteBatch& batch = SpriteBatch::instance();
+    auto at = [&](const FractalNode& node) {
+        return cached ? origin + node.rootOffset : node.worldPosition + origin;
+    };
+    
+    // Соединительные линии от живых узлов к родителям (темно-зеленый), под узлами
+    for (const auto& node : nodes) {
+        if (!node.active || node.parent < 0) continue;
+        Vector2 from = at(nodes[node.parent]);
+        Vector2 to = at(node);
+        batch.drawLine((int)from.x, (int)from.y, (int)to.x, (int)to.y, {30, 100, 30, 255});
+    }
     
     // Рендер всей фрактальной структуры
-    rootNode.render(renderer, position, currentRotation);
+    for (const auto& node : nodes) {
+        if (node.active) {
+            node.render(at(node));
+        }
+    }
     
     // Центральная точка босса (для отладки)
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    Vector2 center = cached ? origin : position + origin;
     SDL_Rect centerPoint = {
-        (int)(position.x - 3),
-        (int)(position.y - 3),
+        (int)(center.x - 3),
+        (int)(center.y - 3),
         6, 6
     };
-    SDL_RenderFillRect(renderer, &centerPoint);
+    batch.fillRect(centerPoint, {255, 255, 255, 255});
 }
 
 void FractalBoss::takeDamage(int damage) {
     // Найти случайный живой узел для нанесения урона
-    std::vector<FractalNode*> livingNodes;
-    collectLivingNodes(&rootNode, livingNodes);
-    
     if (!livingNodes.empty()) {
         // Выбираем случайный живой узел
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(0, livingNodes.size() - 1);
-        
-        FractalNode* targetNode = livingNodes[dis(gen)];
-        targetNode->takeDamage(damage);
-        
-        std::cout << "Damaged fractal node level " << targetNode->nodeLevel 
-                  << ", remaining health: " << targetNode->health << std::endl;
+        int slot = rng(RandomStream::BOSS).rangeInt(0, (int)livingNodes.size() - 1);
+        damageNode(livingNodes[slot], damage);
     }
     
-    // Обновляем здоровье босса
-    updateHealthFromNodes();
-    
     // Вызываем анимацию попадания
     hit();
 }
 
-FractalNode* FractalBoss::findHitNode(Vector2 hitPosition) {
-    float minDistance = std::numeric_limits<float>::max();
-    return rootNode.findClosestNode(hitPosition, position, currentRotation, minDistance);
+bool FractalBoss::takeDamageAt(Vector2 point, float hitRadius, int damage) {
+    int index = findHitNode(point, hitRadius);
+    if (index < 0) return false;
+    
+    damageNode(index, damage);
+    hit();
+    return true;
 }
 
-void FractalBoss::updateHealthFromNodes() {
-    int currentTotalHealth = rootNode.getTotalHealth();
-    int currentLivingNodes = rootNode.countLivingNodes();
-    
-    // Обновляем здоровье босса пропорционально количеству живых узлов
-    health = currentTotalHealth;
+void FractalBoss::damageNode(int index, int damage) {
+    FractalNode& node = nodes[index];
+    int band = node.healthBand();
+    health -= node.takeDamage(damage);
+    if (node.healthBand() != band) {
+        silhouetteDirty = true;
+    }
     
-    // Информация для отладки
-    static int lastNodeCount = -1;
-    if (currentLivingNodes != lastNodeCount) {
-        std::cout << "Living nodes: " << currentLivingNodes << "/" << totalNodes 
-                  << ", Health: " << health << "/" << maxHealth << std::endl;
-        lastNodeCount = currentLivingNodes;
+    if (!node.alive && livingSlot[index] >= 0) {
+        // Nodes under a destroyed node are inactive and can never be hit again,
+        // so the whole subtree dies with it
+        hitStack.clear();
+        hitStack.push_back(index);
+        while (!hitStack.empty()) {
+            int current = hitStack.back();
+            hitStack.pop_back();
+            FractalNode& dying = nodes[current];
+            health -= dying.health;
+            dying.health = 0;
+            dying.alive = false;
+            removeLiving(current);
+            for (int c = dying.firstChild; c >= 0 && c < dying.firstChild + dying.childCount; ++c) {
+                if (nodes[c].alive) {
+                    hitStack.push_back(c);
+                }
+            }
+        }
+        
+        LOG_DEBUG(LogCategory::COMBAT, "Living nodes: %d/%d, Health: %d/%d",
+                  static_cast<int>(livingNodes.size()), totalNodes, health, maxHealth);
     }
 }
 
-int FractalBoss::getMaxHealth() const {
-    return maxHealth;
+void FractalBoss::removeLiving(int index) {
+    int slot = livingSlot[index];
+    if (slot < 0) return;
+    
+    // Swap-remove from the living list
+    int last = livingNodes.back();
+    livingNodes[slot] = last;
+    livingSlot[last] = slot;
+    livingNodes.pop_back();
+    livingSlot[index] = -1;
 }
 
-void FractalBoss::collectLivingNodes(FractalNode* node, std::vector<FractalNode*>& livingNodes) {
-    if (node->alive) {
-        livingNodes.push_back(node);
-    }
+int FractalBoss::findHitNode(Vector2 hitPosition, float hitRadius) {
+    int closest = -1;
+    float minDistanceSq = std::numeric_limits<float>::max();
+    // The silhouette is drawn rotated, so node squares are tested in the structure's frame
+    float cosR = std::cos(currentRotation);
+    float sinR = std::sin(currentRotation);
     
-    // Рекурсивно проверяем дочерние узлы
-    for (auto& child : node->children) {
-        collectLivingNodes(&child, livingNodes);
+    // Inactive nodes have inactive subtrees, so they prune like misses
+    hitStack.clear();
+    if (!nodes.empty() && nodes[0].active) {
+        hitStack.push_back(0);
     }
+    while (!hitStack.empty()) {
+        int index = hitStack.back();
+        hitStack.pop_back();
+        const FractalNode& node = nodes[index];
+        
+        float dx = hitPosition.x - node.worldPosition.x;
+        float dy = hitPosition.y - node.worldPosition.y;
+        float distanceSq = dx * dx + dy * dy;
+        float reach = node.boundsRadius + hitRadius;
+        if (distanceSq > reach * reach) continue; // промах по всей ветке
+        
+        // Круг против повернутого квадрата узла
+        float localX = dx * cosR + dy * sinR;
+        float localY = -dx * sinR + dy * cosR;
+        float outsideX = std::max(std::abs(localX) - node.nodeRadius, 0.0f);
+        float outsideY = std::max(std::abs(localY) - node.nodeRadius, 0.0f);
+        if (outsideX * outsideX + outsideY * outsideY <= hitRadius * hitRadius && distanceSq < minDistanceSq) {
+            minDistanceSq = distanceSq;
+            closest = index;
+        }
+        
+        for (int c = node.firstChild; c >= 0 && c < node.firstChild + node.childCount; ++c) {
+            if (nodes[c].active) {
+                hitStack.push_back(c);
+            }
+        }
+    }
+    return closest;
+}
+
+int FractalBoss::getMaxHealth() const {
+    return maxHealth;
 }
 
 // Factory function
-std::unique_ptr<Enemy> CreateFractalBoss(const Vector2& pos, SDL_Renderer* renderer) {
-    return std::make_unique<FractalBoss>(pos, renderer);
-} 
\ No newline at end of file
+std::unique_ptr<Enemy> CreateFractalBoss(const Vector2& pos) {
+    return std::make_unique<FractalBoss>(pos);
+}
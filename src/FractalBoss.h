@@ -5,20 +5,27 @@
 #include <memory>
 #include <vector>
 
-class Bullet;
+class BulletEmitter;
 
 class FractalBoss : public Enemy {
 public:
-    FractalBoss(Vector2 pos, SDL_Renderer* renderer);
+    explicit FractalBoss(Vector2 pos);
     ~FractalBoss() override;
     
-    void update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) override;
-    void render(SDL_Renderer* renderer) override;
+    void update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) override;
+    void render(SDL_Renderer* renderer, float alpha) override;
+    void onRenderTargetsReset(bool deviceLost) override;
     void takeDamage(int damage) override;
+    bool takeDamageAt(Vector2 point, float hitRadius, int damage) override;
     int getMaxHealth() const override;
     
 private:
-    FractalNode rootNode;           // Корневой узел фрактала
+    // Плоский массив узлов в порядке уровней (корень - nodes[0])
+    std::vector<FractalNode> nodes;
+    // Indices of living nodes, swap-removed on death; livingSlot[i] is node i's position in it
+    std::vector<int> livingNodes;
+    std::vector<int> livingSlot;
+    std::vector<int> hitStack;      // reused traversal stack for findHitNode and damageNode
     float rotationSpeed;            // Скорость вращения (в радианах/сек)
     float currentRotation;          // Текущий угол поворота
     int fractalDepth;              // Глубина фрактала (3 уровня)
@@ -28,13 +35,30 @@ private:
     int totalNodes;                // Общее количество узлов (10 звеньев)
     int maxHealth;                 // Максимальное здоровье босса
     
-    void generateFractal(FractalNode& node, int currentDepth, float size);
+    // The structure only changes shape when a node dies or changes health
+    // band; it is drawn unrotated into this texture then and copied rotated
+    // every frame. Without render target support it is drawn node by node.
+    SDL_Texture* silhouette = nullptr;
+    int silhouetteSize = 0;
+    bool silhouetteDirty = true;
+    bool silhouetteUnsupported = false;
+    
     void initializeFractal();
     void updateRotation(float deltaTime);
-    FractalNode* findHitNode(Vector2 hitPosition);
-    void updateHealthFromNodes();
-    void collectLivingNodes(FractalNode* node, std::vector<FractalNode*>& livingNodes);
+    // One linear pass over the level-ordered array: world positions and active flags
+    void updateTransforms();
+    void computeBounds();
+    // Connections, nodes and center mark. cached: unrotated around origin (the
+    // texture center); otherwise at the world positions shifted by origin
+    void drawStructure(Vector2 origin, bool cached) const;
+    void redrawSilhouette(SDL_Renderer* renderer);
+    // Node whose square, rotated with the structure, the hit circle overlaps (closest centre wins), or -1.
+    // Walks the bounding circle hierarchy, skipping whole branches the hit misses
+    int findHitNode(Vector2 hitPosition, float hitRadius);
+    // A node that dies takes its whole subtree with it
+    void damageNode(int index, int damage);
+    void removeLiving(int index);
 };
 
 // Factory function
-std::unique_ptr<Enemy> CreateFractalBoss(const Vector2& pos, SDL_Renderer* renderer); 
\ No newline at end of file
+std::unique_ptr<Enemy> CreateFractalBoss(const Vector2& pos); 
\ No newline at end of file
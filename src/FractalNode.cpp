@@ -1,11 +1,14 @@
 #include "FractalNode.h"
-#include "Bullet.h"
+#include "BulletPool.h"
+#include "Random.h"
+#include "Logger.h"
+#include "SpriteBatch.h"
 #include <cmath>
 #include <algorithm>
-#include <iostream>
 
-FractalNode::FractalNode(Vector2 offset, int hp, int level) 
-    : localOffset(offset), shootTimer(0.0f), health(hp), maxHealth(hp), 
+FractalNode::FractalNode(Vector2 offset, int hp, int level, int parentIndex) 
+    : localOffset(offset), rootOffset(0, 0), parent(parentIndex), firstChild(-1), childCount(0),
+      worldPosition(0, 0), boundsRadius(0.0f), active(true), shootTimer(0.0f), health(hp), maxHealth(hp), 
       alive(true), nodeLevel(level) {
     
     // Настройка параметров в зависимости от уровня
@@ -38,26 +41,13 @@ FractalNode::FractalNode(Vector2 offset, int hp, int level)
     }
     
     // Случайный разброс в интервале стрельбы для асинхронности
-    shootTimer = static_cast<float>(rand()) / RAND_MAX * shootInterval;
+    shootTimer = rng(RandomStream::BOSS).range(0.0f, shootInterval);
 }
 
-void FractalNode::update(float deltaTime, Vector2 parentWorldPos, float rotation, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
-    if (!alive) return;
-    
-    shootTimer += deltaTime;
-    
-    // Попытка выстрела
-    tryShoot(playerPos, bullets, parentWorldPos, rotation);
-    
-    // Обновление дочерних узлов
-    updateChildren(deltaTime, getWorldPosition(parentWorldPos, rotation), rotation, playerPos, bullets);
-}
-
-void FractalNode::tryShoot(Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets, Vector2 parentWorldPos, float rotation) {
+void FractalNode::tryShoot(Vector2 playerPos, BulletEmitter& bullets) {
     if (!alive || shootTimer < shootInterval) return;
     
-    Vector2 worldPos = getWorldPosition(parentWorldPos, rotation);
-    Vector2 toPlayer = (playerPos - worldPos).normalized();
+    Vector2 toPlayer = (playerPos - worldPosition).normalized();
     
     // Создаем пулю с цветом в зависимости от уровня узла
     BulletType bulletType;
@@ -68,84 +58,35 @@ void FractalNode::tryShoot(Vector2 playerPos, std::vector<std::unique_ptr<Bullet
         default: bulletType = BulletType::BOSS_BULLET; break;    // Оранжевые пули по умолчанию
     }
     
-    bullets.push_back(std::make_unique<Bullet>(
-        worldPos, 
+    bullets.spawn(
+        worldPosition, 
         toPlayer, 
         8 + nodeLevel * 2,  // Урон зависит от уровня
         500.0f, 
         300.0f + nodeLevel * 50.0f,  // Скорость зависит от уровня
         bulletType, 
         true
-    ));
+    );
     
     shootTimer = 0.0f;
 }
 
-Vector2 FractalNode::getWorldPosition(Vector2 parentPos, float rotation) const {
-    // Поворот локального смещения на угол rotation
-    float cosR = std::cos(rotation);
-    float sinR = std::sin(rotation);
-    
-    Vector2 rotatedOffset(
-        localOffset.x * cosR - localOffset.y * sinR,
-        localOffset.x * sinR + localOffset.y * cosR
-    );
+int FractalNode::takeDamage(int damage) {
+    if (!alive || damage <= 0) return 0;
     
-    return parentPos + rotatedOffset;
-}
-
-void FractalNode::takeDamage(int damage) {
-    health -= damage;
+    int dealt = damage < health ? damage : health;
+    health -= dealt;
     if (health <= 0) {
         health = 0;
         alive = false;
-        std::cout << "Fractal node level " << nodeLevel << " destroyed!" << std::endl;
-    }
-}
-
-bool FractalNode::hasLivingChildren() const {
-    for (const auto& child : children) {
-        if (child.alive || child.hasLivingChildren()) {
-            return true;
-        }
-    }
-    return false;
-}
-
-int FractalNode::getTotalHealth() const {
-    int totalHealth = alive ? health : 0;
-    for (const auto& child : children) {
-        totalHealth += child.getTotalHealth();
-    }
-    return totalHealth;
-}
-
-int FractalNode::countLivingNodes() const {
-    int count = alive ? 1 : 0;
-    for (const auto& child : children) {
-        count += child.countLivingNodes();
+        LOG_DEBUG(LogCategory::COMBAT, "Fractal node level %d destroyed!", nodeLevel);
     }
-    return count;
+    return dealt;
 }
 
-void FractalNode::render(SDL_Renderer* renderer, Vector2 parentPos, float rotation) const {
-    if (!alive) return;
-    
-    Vector2 worldPos = getWorldPosition(parentPos, rotation);
-    
-    // Рендер соединительных линий к живым детям (темно-зеленый)
-    SDL_SetRenderDrawColor(renderer, 30, 100, 30, 255);
-    for (const auto& child : children) {
-        if (child.alive) {
-            Vector2 childWorldPos = child.getWorldPosition(worldPos, rotation);
-            SDL_RenderDrawLine(renderer, 
-                (int)worldPos.x, (int)worldPos.y,
-                (int)childWorldPos.x, (int)childWorldPos.y);
-        }
-    }
-    
+void FractalNode::render(Vector2 center) const {
     // Основной узел - квадрат с зеленым цветом в зависимости от уровня и здоровья
-    float healthPercent = static_cast<float>(health) / maxHealth;
+    float healthPercent = static_cast<float>(healthBand()) / HEALTH_BANDS;
     
     // Зеленые оттенки в зависимости от уровня узла
     Uint8 red, green, blue;
@@ -172,65 +113,23 @@ void FractalNode::render(SDL_Renderer* renderer, Vector2 parentPos, float rotati
             break;
     }
     
-    SDL_SetRenderDrawColor(renderer, red, green, blue, 255);
+    SpriteBatch& batch = SpriteBatch::instance();
     SDL_Rect nodeRect = {
-        (int)(worldPos.x - nodeRadius),
-        (int)(worldPos.y - nodeRadius),
+        (int)(center.x - nodeRadius),
+        (int)(center.y - nodeRadius),
         (int)(nodeRadius * 2),
         (int)(nodeRadius * 2)
     };
-    SDL_RenderFillRect(renderer, &nodeRect);
+    batch.fillRect(nodeRect, {red, green, blue, 255});
     
     // Контур узла (темно-зеленый)
-    SDL_SetRenderDrawColor(renderer, 20, 80, 20, 255);
-    SDL_RenderDrawRect(renderer, &nodeRect);
+    batch.drawRect(nodeRect, {20, 80, 20, 255});
     
     // Индикатор уровня узла (маленькая точка в центре)
-    SDL_SetRenderDrawColor(renderer, bulletColor.r, bulletColor.g, bulletColor.b, 255);
     SDL_Rect centerDot = {
-        (int)(worldPos.x - 2),
-        (int)(worldPos.y - 2),
+        (int)(center.x - 2),
+        (int)(center.y - 2),
         4, 4
     };
-    SDL_RenderFillRect(renderer, &centerDot);
-    
-    // Рендер дочерних узлов
-    renderChildren(renderer, worldPos, rotation);
+    batch.fillRect(centerDot, {bulletColor.r, bulletColor.g, bulletColor.b, 255});
 }
-
-FractalNode* FractalNode::findClosestNode(Vector2 hitPosition, Vector2 parentPos, float rotation, float& minDistance) {
-    if (!alive) return nullptr;
-    
-    Vector2 worldPos = getWorldPosition(parentPos, rotation);
-    float distance = worldPos.distance(hitPosition);
-    
-    FractalNode* closestNode = nullptr;
-    
-    // Проверяем попадание в этот узел
-    if (distance <= nodeRadius && distance < minDistance) {
-        minDistance = distance;
-        closestNode = this;
-    }
-    
-    // Проверяем дочерние узлы
-    for (auto& child : children) {
-        FractalNode* childClosest = child.findClosestNode(hitPosition, worldPos, rotation, minDistance);
-        if (childClosest) {
-            closestNode = childClosest;
-        }
-    }
-    
-    return closestNode;
-}
-
-void FractalNode::updateChildren(float deltaTime, Vector2 worldPos, float rotation, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
-    for (auto& child : children) {
-        child.update(deltaTime, worldPos, rotation, playerPos, bullets);
-    }
-}
-
-void FractalNode::renderChildren(SDL_Renderer* renderer, Vector2 worldPos, float rotation) const {
-    for (const auto& child : children) {
-        child.render(renderer, worldPos, rotation);
-    }
-} 
\ No newline at end of file
@@ -1,15 +1,24 @@
 #pragma once
 #include <SDL2/SDL.h>
-#include <vector>
-#include <memory>
 #include "Vector2.h"
 
-class Bullet;
+class BulletEmitter;
 
+// One node of the fractal boss. Nodes live in a flat, level-ordered array
+// owned by FractalBoss: a parent always comes before its children, and the
+// children of a node are contiguous at [firstChild, firstChild + childCount).
 class FractalNode {
 public:
+    static const int HEALTH_BANDS = 8; // color steps between dead and full health
+
     Vector2 localOffset;              // Смещение относительно родителя
-    std::vector<FractalNode> children; // Дочерние узлы
+    Vector2 rootOffset;               // Unrotated offset from the root, for the cached silhouette
+    int parent;                       // Индекс родителя в массиве (-1 у корня)
+    int firstChild;                   // Индекс первого ребенка (-1 у листьев)
+    int childCount;
+    Vector2 worldPosition;            // Пересчитывается раз в кадр FractalBoss::updateTransforms
+    float boundsRadius;               // Circle around worldPosition enclosing this node's whole subtree
+    bool active;                      // Жив сам узел и вся цепочка родителей
     float shootTimer;                 // Таймер до следующего выстрела
     float shootInterval;              // Интервал между выстрелами
     int health;                       // Здоровье узла
@@ -19,21 +28,14 @@ public:
     int nodeLevel;                    // Уровень узла в фрактале (0=центр, 1,2,3=периферия)
     SDL_Color bulletColor;            // Цвет пуль этого узла
     
-    FractalNode(Vector2 offset = Vector2(0, 0), int hp = 200, int level = 0);
-    
-    void update(float deltaTime, Vector2 parentWorldPos, float rotation, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets);
-    void tryShoot(Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets, Vector2 parentWorldPos, float rotation);
-    Vector2 getWorldPosition(Vector2 parentPos, float rotation) const;
-    void takeDamage(int damage);
-    bool hasLivingChildren() const;
-    int getTotalHealth() const;         // Суммарное здоровье узла и детей
-    int countLivingNodes() const;       // Подсчет живых узлов в ветке
-    void render(SDL_Renderer* renderer, Vector2 parentPos, float rotation) const;
-    
-    // Поиск ближайшего живого узла к точке
-    FractalNode* findClosestNode(Vector2 hitPosition, Vector2 parentPos, float rotation, float& minDistance);
+    FractalNode(Vector2 offset = Vector2(0, 0), int hp = 200, int level = 0, int parentIndex = -1);
     
-private:
-    void updateChildren(float deltaTime, Vector2 worldPos, float rotation, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets);
-    void renderChildren(SDL_Renderer* renderer, Vector2 worldPos, float rotation) const;
-}; 
\ No newline at end of file
+    // Uses worldPosition, so transforms must be current
+    void tryShoot(Vector2 playerPos, BulletEmitter& bullets);
+    // Returns the health actually removed (never more than what was left)
+    int takeDamage(int damage);
+    // Color step the node is drawn with; the boss redraws its silhouette when it changes
+    int healthBand() const { return health * HEALTH_BANDS / maxHealth; }
+    // Square, outline and level dot centered on center
+    void render(Vector2 center) const;
+};
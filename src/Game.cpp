@@ -5,22 +5,29 @@
 #include "MiniBossEnemy.h"
 #include "FractalBoss.h"
 #include "CentipedeEnemy.h"
+#include "TextureCache.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "Logger.h"
+#include "JobSystem.h"
 #include <cmath>
-#include <iostream>
-#include <random>
 #include <algorithm>
 #include <SDL2/SDL_image.h>
 #include <sstream>
 #include <iomanip>
 #include <cstdio> // Add for sprintf
 #include <string>
-#include <map>
 
 Game::Game() : window(nullptr), renderer(nullptr), running(false),
 timeSinceLastSpawn(0), score(0), wave(1), mousePos(0, 0),
 waveTimer(0), waveDuration(10.0f), waveActive(true), materialBag(0),
 currentBoss(nullptr), bossSpawnedThisWave(false), swarmSpawnedThisWave(false),
-lastBossType(BossType::NONE), defaultFont(nullptr) {
+lastBossType(BossType::NONE),
+enemyGrid(WINDOW_WIDTH, WINDOW_HEIGHT, COLLISION_CELL_SIZE),
+orbGrid(WINDOW_WIDTH, WINDOW_HEIGHT, COLLISION_CELL_SIZE),
+materialGrid(WINDOW_WIDTH, WINDOW_HEIGHT, COLLISION_CELL_SIZE) {
 
 }
 
@@ -28,50 +35,125 @@ Game::~Game() {
 	cleanup();
 }
 
-bool Game::init() {
+bool Game::init(const GameConfig& gameConfig) {
+	config = gameConfig;
+
+	if (!config.replayPath.empty()) {
+		ReplayHeader header;
+		if (!replayReader.open(config.replayPath, header)) {
+			return false;
+		}
+		// The recorded input only reproduces the run under the settings it was recorded with
+		config.seed = header.seed;
+		config.tickRate = header.tickRate;
+		config.spawnMultiplier = header.spawnMultiplier;
+		config.autoCloseShop = header.autoCloseShop;
+		LOG_INFO(LogCategory::GAME, "Replaying %s: %u ticks", config.replayPath.c_str(), replayReader.getTickCount());
+	}
+
+	if (config.seed == 0) {
+		config.seed = Random::seedFromEntropy();
+	}
+	Random::instance().seed(config.seed);
+	LOG_INFO(LogCategory::GAME, "Random seed: %llu", static_cast<unsigned long long>(config.seed));
+
+	if (!config.recordPath.empty()) {
+		if (config.headless && !replayReader.isOpen()) {
+			LOG_WARN(LogCategory::GAME, "Headless runs have no input to record - ignoring %s", config.recordPath.c_str());
+		} else {
+			ReplayHeader header;
+			header.seed = config.seed;
+			header.tickRate = config.tickRate;
+			header.spawnMultiplier = config.spawnMultiplier;
+			header.autoCloseShop = config.autoCloseShop;
+			if (!replayWriter.open(config.recordPath, header)) {
+				return false;
+			}
+			LOG_INFO(LogCategory::GAME, "Recording input to %s", config.recordPath.c_str());
+		}
+	}
+
+	JobSystem::instance().init(config.workerThreads);
+	LOG_INFO(LogCategory::GAME, "Job system: %d worker threads", JobSystem::instance().getWorkerCount());
+
+	if (config.headless) {
+		return initHeadless();
+	}
+
 	if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-		std::cout << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
+		LOG_ERROR(LogCategory::GAME, "SDL could not initialize! SDL_Error: %s", SDL_GetError());
 		return false;
 	}
 
 	// Initialize SDL_image
 	int imgFlags = IMG_INIT_PNG;
 	if (!(IMG_Init(imgFlags) & imgFlags)) {
-		std::cout << "SDL_image could not initialize! SDL_image Error: " << IMG_GetError() << std::endl;
+		LOG_ERROR(LogCategory::GAME, "SDL_image could not initialize! SDL_image Error: %s", IMG_GetError());
 		return false;
 	}
 
 	// Initialize SDL_ttf
 	if (TTF_Init() == -1) {
-		std::cout << "SDL_ttf could not initialize! SDL_ttf Error: " << TTF_GetError() << std::endl;
+		LOG_ERROR(LogCategory::GAME, "SDL_ttf could not initialize! SDL_ttf Error: %s", TTF_GetError());
 		return false;
 	}
 
+	Uint32 windowFlags = SDL_WINDOW_SHOWN;
+	if (config.fullscreen) {
+		windowFlags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
+	}
 	window = SDL_CreateWindow("Brotato MVP",
 		SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
-		WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_SHOWN | SDL_WINDOW_FULLSCREEN_DESKTOP);
+		WINDOW_WIDTH, WINDOW_HEIGHT, windowFlags);
 	if (window == nullptr) {
-		std::cout << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+		LOG_ERROR(LogCategory::GAME, "Window could not be created! SDL_Error: %s", SDL_GetError());
 		return false;
 	}
 
-	renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+	Uint32 rendererFlags = config.softwareRenderer ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED;
+	if (config.vsync) {
+		rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+	}
+	renderer = SDL_CreateRenderer(window, -1, rendererFlags);
 	if (renderer == nullptr) {
-		std::cout << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+		LOG_ERROR(LogCategory::GAME, "Renderer could not be created! SDL_Error: %s", SDL_GetError());
 		return false;
 	}
 
-	player = std::make_unique<Player>(WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2);
-
-	// Initialize player with renderer for sprite loading
-	player->initialize(renderer);
-
-	// Initialize player weapons with renderer for sprite loading
-	player->initializeWeapons(renderer);
-
-	shop = std::make_unique<Shop>();
-	shop->setGame(this);
-	shop->loadAssets(renderer);
+	// Decode and upload every sprite once, packed into the sprite atlas; entities
+	// only take references afterwards
+	TextureCache& textureCache = TextureCache::instance();
+	textureCache.init(renderer);
+	textureCache.preload({
+		"monsters/landmonster/Transparent PNG/idle/frame-1.png",
+		"monsters/landmonster/Transparent PNG/idle/frame-2.png",
+		"monsters/landmonster/Transparent PNG/got hit/frame.png",
+		"assets/enemies/slime.png",
+		"assets/enemies/pebblin.png",
+		"assets/enemies/bossT.png",
+		"assets/enemies/bossT_rush.png",
+		"assets/character/brick.png",
+		"assets/weapons/pistol.png",
+		"assets/weapons/pistol2.png",
+		"assets/weapons/pistol3.png",
+		"assets/weapons/smg.png",
+		"assets/weapons/brickonstick.png",
+		"assets/weapons/shotgun.png",
+		"assets/weapons/sniper2.png",
+		"assets/ui/card_normal.png",
+		"assets/ui/coin.png",
+		"assets/ui/heart.png",
+		"assets/ui/speed_up_booster.png",
+		"assets/ui/healing_booster.png"
+	});
+
+	// Bullets, orbs, materials, muzzle flash and the UI materials badge
+	PrimitiveCache& primitives = PrimitiveCache::instance();
+	primitives.init(renderer);
+	primitives.preloadCircles({ 3, 4, 6, 7, 8, 35, 40 });
+	SpriteBatch::instance().init(renderer);
+
+	initWorld();
 
 	// Try to load fonts in order of preference
 	const char* fontPaths[] = {
@@ -81,17 +163,10 @@ bool Game::init() {
 		"C:/Windows/Fonts/consola.ttf"
 	};
 
-	defaultFont = nullptr;
-	for (const char* fontPath : fontPaths) {
-		defaultFont = TTF_OpenFont(fontPath, 16);
-		if (defaultFont) {
-			std::cout << "Loaded font: " << fontPath << std::endl;
-			break;
-		}
-	}
-
-	if (!defaultFont) {
-		std::cout << "No TTF font available - using bitmap fallback" << std::endl;
+	bitmapFont.init(renderer);
+	hud.init(renderer);
+	if (!textRenderer.init(renderer, { std::begin(fontPaths), std::end(fontPaths) })) {
+		LOG_WARN(LogCategory::ASSETS, "No TTF font available - using bitmap fallback");
 		// Continue without TTF font - will fall back to bitmap rendering
 	}
 
@@ -100,45 +175,149 @@ bool Game::init() {
 	return true;
 }
 
+bool Game::initHeadless() {
+	// Timer functions only - no video, image or font subsystems
+	if (SDL_Init(0) < 0) {
+		LOG_ERROR(LogCategory::GAME, "SDL could not initialize! SDL_Error: %s", SDL_GetError());
+		return false;
+	}
+
+	// Without a renderer the texture cache hands out nullptr and never touches disk
+	TextureCache::instance().init(nullptr);
+	initWorld();
+
+	running = true;
+	return true;
+}
+
+void Game::initWorld() {
+	enemies.reserve(256);
+
+	player = std::make_unique<Player>(WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2);
+
+	// Sprites come from the texture cache (nullptr when headless)
+	player->initialize();
+	player->initializeWeapons();
+
+	shop = std::make_unique<Shop>();
+	shop->setGame(this);
+	shop->loadAssets();
+}
+
 void Game::run() {
-	Uint32 lastTime = SDL_GetTicks();
+	const float fixedDeltaTime = 1.0f / config.tickRate;
+
+	if (config.headless) {
+		// Nothing to present or wait for - run the fixed ticks as fast as possible
+		while (running) {
+			tick(fixedDeltaTime);
+			Profiler::instance().endFrame();
+		}
+		return;
+	}
+
+	// Fixed-step simulation: real time accumulates and is consumed in whole ticks,
+	// rendering blends the last two ticks with the leftover fraction
+	const double counterFrequency = static_cast<double>(SDL_GetPerformanceFrequency());
+	Uint64 lastCounter = SDL_GetPerformanceCounter();
+	double accumulator = 0.0;
 
 	while (running) {
-		Uint32 currentTime = SDL_GetTicks();
-		float deltaTime = (currentTime - lastTime) / 1000.0f;
-		lastTime = currentTime;
+		Uint64 currentCounter = SDL_GetPerformanceCounter();
+		double frameSeconds = (currentCounter - lastCounter) / counterFrequency;
+		lastCounter = currentCounter;
+
+		// After a stall (window drag, breakpoint) skip ahead instead of replaying every missed tick
+		if (frameSeconds > MAX_FRAME_SECONDS) {
+			frameSeconds = MAX_FRAME_SECONDS;
+		}
+		accumulator += frameSeconds;
 
 		handleEvents();
-		update(deltaTime);
-		render();
 
-		SDL_Delay(16);
+		while (accumulator >= fixedDeltaTime && running) {
+			tick(fixedDeltaTime);
+			accumulator -= fixedDeltaTime;
+		}
+
+		render(static_cast<float>(accumulator / fixedDeltaTime));
+		Profiler::instance().endFrame();
+	}
+}
+
+void Game::storePreviousPositions() {
+	player->storePreviousPosition();
+	bullets.storePreviousPositions();
+	experienceOrbs.storePreviousPositions();
+	materials.storePreviousPositions();
+	for (auto& enemy : enemies) {
+		enemy->storePreviousPosition();
+	}
+	if (currentBoss) {
+		currentBoss->storePreviousPosition();
 	}
 }
 
 void Game::handleEvents() {
+	PROFILE_SCOPE("Game::handleEvents");
 	SDL_Event e;
 	while (SDL_PollEvent(&e) != 0) {
 		if (e.type == SDL_QUIT) {
 			running = false;
 		}
+		else if (e.type == SDL_KEYDOWN && !e.key.repeat && e.key.keysym.sym == SDLK_F3) {
+			showProfilerOverlay = !showProfilerOverlay;
+		}
+		else if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+			// The cached HUD, shop and boss silhouette textures lost their contents
+			hud.invalidateAll();
+			shop->invalidate();
+			if (currentBoss) {
+				currentBoss->onRenderTargetsReset(e.type == SDL_RENDER_DEVICE_RESET);
+			}
+		}
 	}
 
-	// Get mouse position
-	int mouseX, mouseY;
-	SDL_GetMouseState(&mouseX, &mouseY);
-	mousePos = Vector2(static_cast<float>(mouseX), static_cast<float>(mouseY));
+	// Applied by every tick until the next frame samples again
+	liveInput = InputFrame::sample();
+}
 
-	const Uint8* keyState = SDL_GetKeyboardState(nullptr);
+void Game::tick(float deltaTime) {
+	InputFrame input = liveInput;
+	if (replayReader.isOpen() && !replayReader.next(input)) {
+		LOG_INFO(LogCategory::GAME, "Replay finished after %u ticks", tickCount);
+		running = false;
+		return;
+	}
+	replayWriter.write(input);
+
+	// Headless runs without a replay have no input; scripted drivers use applyInput() instead
+	if (!config.headless || replayReader.isOpen()) {
+		applyInputFrame(input);
+	}
+	update(deltaTime);
+	tickCount++;
+
+	if (tickCount % REPLAY_CHECKSUM_INTERVAL == 0 && (replayWriter.isOpen() || replayReader.isOpen())) {
+		uint32_t checksum = stateChecksum();
+		replayWriter.writeChecksum(tickCount, checksum);
+		if (replayReader.isOpen() && !replayReader.verify(tickCount, checksum) &&
+			replayReader.getDivergedTick() == tickCount) {
+			LOG_WARN(LogCategory::GAME, "Replay diverged from the recording at tick %u (wave %d)", tickCount, wave);
+		}
+	}
+}
+
+void Game::applyInputFrame(const InputFrame& input) {
+	mousePos = Vector2(static_cast<float>(input.mouseX), static_cast<float>(input.mouseY));
+
+	Uint8 keyState[SDL_NUM_SCANCODES];
+	input.toKeyState(keyState);
 
 	// Handle shop input if shop is active
 	if (shop->isShopActive()) {
 		shop->handleInput(keyState, *player);
-
-		// Handle mouse input for shop
-		Uint32 mouseState = SDL_GetMouseState(&mouseX, &mouseY);
-		bool mousePressed = (mouseState & SDL_BUTTON(SDL_BUTTON_LEFT)) != 0;
-		shop->handleMouseInput(mouseX, mouseY, mousePressed, *player);
+		shop->handleMouseInput(input.mouseX, input.mouseY, input.isHeld(InputButton::MOUSE_LEFT), *player);
 	}
 	else {
 		player->handleInput(keyState);
@@ -148,17 +327,73 @@ void Game::handleEvents() {
 	}
 }
 
+uint32_t Game::stateChecksum() const {
+	// FNV-1a over the values a divergence shows up in first
+	uint32_t hash = 2166136261u;
+	auto mix = [&hash](const void* data, size_t size) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash = (hash ^ bytes[i]) * 16777619u;
+		}
+	};
+
+	int values[] = { wave, score, player->getHealth(), player->getStats().materials, materialBag,
+		static_cast<int>(enemies.size()), bullets.size(),
+		static_cast<int>(experienceOrbs.size()), static_cast<int>(materials.size()), currentBoss ? 1 : 0 };
+	mix(values, sizeof(values));
+	Vector2 playerPos = player->getPosition();
+	mix(&playerPos.x, sizeof(playerPos.x));
+	mix(&playerPos.y, sizeof(playerPos.y));
+	for (const auto& enemy : enemies) {
+		Vector2 position = enemy->getPosition();
+		mix(&position.x, sizeof(position.x));
+		mix(&position.y, sizeof(position.y));
+	}
+	return hash;
+}
+
+void Game::applyInput(const GameInput& input) {
+	if (shop->isShopActive()) {
+		return;
+	}
+	player->setMoveInput(input.move);
+	player->updateShootDirection(input.aimTarget);
+}
+
+Enemy* Game::findEnemy(SlotHandle handle) const {
+	const std::unique_ptr<Enemy>* enemy = enemies.get(handle);
+	return enemy ? enemy->get() : nullptr;
+}
+
+EntityCounts Game::getEntityCounts() const {
+	EntityCounts counts;
+	counts.enemies = static_cast<int>(enemies.size()) + (currentBoss ? 1 : 0);
+	counts.bullets = bullets.size();
+	counts.orbs = static_cast<int>(experienceOrbs.size());
+	counts.materials = static_cast<int>(materials.size());
+	return counts;
+}
+
 void Game::update(float deltaTime) {
+	PROFILE_SCOPE("Game::update");
 	if (player->getHealth() <= 0) {
 		running = false;
 		return;
 	}
 
+	// Snapshot the state render() interpolates from
+	storePreviousPositions();
+
 	// Don't update game if shop is active
 	if (shop->isShopActive()) {
-		return;
+		if (!config.autoCloseShop) {
+			return;
+		}
+		shop->closeShop();
 	}
 
+	combatTime += deltaTime;
+
 	// Update wave timer
 	if (waveActive) {
 		waveTimer += deltaTime;
@@ -166,7 +401,7 @@ void Game::update(float deltaTime) {
 			// Wave completed - distribute bagged materials
 			if (materialBag > 0) {
 				player->gainMaterials(materialBag);
-				std::cout << "Collected " << materialBag << " materials from bag!" << std::endl;
+				LOG_INFO(LogCategory::GAME, "Collected %d materials from bag!", materialBag);
 				materialBag = 0;
 			}
 
@@ -185,7 +420,7 @@ void Game::update(float deltaTime) {
 				lastBossType = BossType::NONE;
 			}
 
-			std::cout << "Wave " << wave << " will start after shop" << std::endl;
+			LOG_INFO(LogCategory::GAME, "Wave %d will start after shop", wave);
 
 			// Increase wave duration by 2.5 seconds each wave, capped at 30 seconds
 			if (waveDuration < 30.0f) {
@@ -200,16 +435,38 @@ void Game::update(float deltaTime) {
 	// Update weapons (they will fire in aim direction)
 	player->updateWeapons(deltaTime, bullets);
 
-	for (auto& bullet : bullets) {
-		bullet->update(deltaTime);
+	JobSystem& jobs = JobSystem::instance();
+	{
+		PROFILE_SCOPE("Game::update bullets");
+		jobs.parallelFor(bullets.size(), BULLET_UPDATE_GRAIN, [&](int, int begin, int end) {
+			bullets.updateRange(begin, end, deltaTime);
+		});
 	}
 
-	for (auto& enemy : enemies) {
-		enemy->update(deltaTime, player->getPosition(), bullets);
+	{
+		PROFILE_SCOPE("Game::update enemies");
+		// Compute in parallel, each chunk firing into its own buffer...
+		Vector2 playerPos = player->getPosition();
+		int enemyCount = (int)enemies.size();
+		int chunks = JobSystem::chunkCount(enemyCount, ENEMY_UPDATE_GRAIN);
+		if ((int)enemyBulletBuffers.size() < chunks) {
+			enemyBulletBuffers.resize(chunks);
+		}
+		jobs.parallelFor(enemyCount, ENEMY_UPDATE_GRAIN, [&](int chunk, int begin, int end) {
+			BulletCommandBuffer& buffer = enemyBulletBuffers[chunk];
+			for (int i = begin; i < end; ++i) {
+				enemies[i]->update(deltaTime, playerPos, buffer);
+			}
+		});
+		// ...then commit serially, in chunk order
+		for (int chunk = 0; chunk < chunks; ++chunk) {
+			enemyBulletBuffers[chunk].flushTo(bullets);
+		}
 	}
 
 	// Обновление босса
 	if (currentBoss) {
+		PROFILE_SCOPE("Game::update boss");
 		currentBoss->update(deltaTime, player->getPosition(), bullets);
 		if (!currentBoss->isAlive()) {
 			currentBoss.reset(); // Освобождаем босса
@@ -218,25 +475,27 @@ void Game::update(float deltaTime) {
 
 	updateSpawnIndicators(deltaTime);
 
-	for (auto& orb : experienceOrbs) {
-		orb->update(deltaTime);
-	}
-
-	for (auto& material : materials) {
-		material->update(deltaTime);
+	{
+		PROFILE_SCOPE("Game::update pickups");
+		Vector2 playerPos = player->getPosition();
+		jobs.parallelFor(experienceOrbs.size(), PICKUP_UPDATE_GRAIN, [&](int, int begin, int end) {
+			experienceOrbs.updateRange(begin, end, deltaTime, playerPos);
+		});
+		jobs.parallelFor(materials.size(), PICKUP_UPDATE_GRAIN, [&](int, int begin, int end) {
+			materials.updateRange(begin, end, deltaTime, playerPos);
+		});
 	}
 
 	// Handle booster lifetime and periodic spawn (at most one)
 	boosterSpawnTimer += deltaTime;
 	if (!speedUpBooster && boosterSpawnTimer >= 10.0f) {
 		boosterSpawnTimer = 0.0f;
-		static std::random_device rd;
-		static std::mt19937 gen(rd());
-		std::uniform_real_distribution<float> xdist(50.0f, static_cast<float>(WINDOW_WIDTH - 50));
-		std::uniform_real_distribution<float> ydist(50.0f, static_cast<float>(WINDOW_HEIGHT - 50));
-		Vector2 spawnPos(xdist(gen), ydist(gen));
+		Rng& gen = rng(RandomStream::BOOSTERS);
+		float x = gen.range(50.0f, static_cast<float>(WINDOW_WIDTH - 50));
+		float y = gen.range(50.0f, static_cast<float>(WINDOW_HEIGHT - 50));
+		Vector2 spawnPos(x, y);
 		speedUpBooster = std::make_unique<SpeedUpBooster>(spawnPos);
-		speedUpBooster->initialize(renderer);
+		speedUpBooster->initialize();
 	}
 	if (speedUpBooster) {
 		speedUpBooster->update(deltaTime);
@@ -249,13 +508,12 @@ void Game::update(float deltaTime) {
 	healingBoosterSpawnTimer += deltaTime;
 	if (!healingBooster && healingBoosterSpawnTimer >= 15.0f) {
 		healingBoosterSpawnTimer = 0.0f;
-		static std::random_device rd;
-		static std::mt19937 gen(rd());
-		std::uniform_real_distribution<float> xdist(50.0f, static_cast<float>(WINDOW_WIDTH - 50));
-		std::uniform_real_distribution<float> ydist(50.0f, static_cast<float>(WINDOW_HEIGHT - 50));
-		Vector2 spawnPos(xdist(gen), ydist(gen));
+		Rng& gen = rng(RandomStream::BOOSTERS);
+		float x = gen.range(50.0f, static_cast<float>(WINDOW_WIDTH - 50));
+		float y = gen.range(50.0f, static_cast<float>(WINDOW_HEIGHT - 50));
+		Vector2 spawnPos(x, y);
 		healingBooster = std::make_unique<HealingBooster>(spawnPos);
-		healingBooster->initialize(renderer);
+		healingBooster->initialize();
 	}
 	if (healingBooster) {
 		healingBooster->update(deltaTime);
@@ -264,92 +522,65 @@ void Game::update(float deltaTime) {
 		}
 	}
 
-	spawnEnemies();
+	spawnEnemies(deltaTime);
+	rebuildEnemyGrid();
 	checkCollisions();
 	checkMeleeAttacks();
-	updateExperienceCollection();
-	updateMaterialCollection();
+	processDamageEvents();
+	processDeathEvents();
+	processDropEvents();
+	updatePickupCollection(experienceOrbs, orbGrid, ORB_COALESCE_THRESHOLD);
+	updatePickupCollection(materials, materialGrid, MATERIAL_COALESCE_THRESHOLD);
+	processPickupEvents();
 	updateBoosterCollection();
 
-	bullets.erase(std::remove_if(bullets.begin(), bullets.end(),
-		[](const std::unique_ptr<Bullet>& bullet) {
-			return !bullet->isAlive();
-		}), bullets.end());
-
-	enemies.erase(std::remove_if(enemies.begin(), enemies.end(),
-		[&](const std::unique_ptr<Enemy>& enemy) {
-			if (!enemy->isAlive()) {
-				// Brotato-style material drop system
-				float dropChance = getMaterialDropChance();
-				static std::random_device rd;
-				static std::mt19937 gen(rd());
-				std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-
-				if (dist(gen) < dropChance) {
-					// Check material limit on map
-					if (materials.size() < MAX_MATERIALS_ON_MAP) {
-						int matValue = 1 + (wave / 3);
-						int expValue = 1 + (wave / 5);
-						materials.push_back(std::make_unique<Material>(
-							enemy->getPosition(), matValue, expValue
-						));
-					}
-					else {
-						// Add to bag if map is full
-						materialBag += 1 + (wave / 3);
-					}
-				}
+	bullets.compact();
 
-				score += 10;
-				return true;
-			}
-			return false;
-		}), enemies.end());
-
-	experienceOrbs.erase(std::remove_if(experienceOrbs.begin(), experienceOrbs.end(),
-		[](const std::unique_ptr<ExperienceOrb>& orb) {
-			return !orb->isAlive();
-		}), experienceOrbs.end());
-
-	materials.erase(std::remove_if(materials.begin(), materials.end(),
-		[&](const std::unique_ptr<Material>& material) {
-			if (!material->isAlive()) {
-				// Add uncollected materials to bag
-				materialBag += material->getMaterialValue();
-				return true;
-			}
-			return false;
-		}), materials.end());
+	// Kills were scored and dropped by processDeathEvents
+	enemies.removeIf(
+		[](const std::unique_ptr<Enemy>& enemy) {
+			return !enemy->isAlive();
+		});
+
+	experienceOrbs.compact();
+	// Add uncollected materials to bag
+	materialBag += materials.compact();
 }
 
-void Game::updateExperienceCollection() {
+void Game::updatePickupCollection(PickupStore& store, SpatialGrid& grid, int coalesceThreshold) {
+	PROFILE_SCOPE("Game::updatePickupCollection");
 	Vector2 playerPos = player->getPosition();
-	float pickupRange = player->getStats().pickupRange;
-
-	for (auto& orb : experienceOrbs) {
-		if (orb->isAlive()) {
-			float distance = playerPos.distance(orb->getPosition());
-			if (distance <= pickupRange) {
-				player->gainExperience(orb->getExperienceValue());
-				orb->collect();
-			}
+	float magnetRange = player->getStats().pickupRange;
+	float magnetRangeSq = magnetRange * magnetRange;
+	float collectRange = player->getRadius();
+	float collectRangeSq = collectRange * collectRange;
+
+	// Built here rather than with the enemy grid so this tick's drops are included
+	grid.clear();
+	store.insertInto(grid);
+	grid.build();
+
+	if (store.size() > coalesceThreshold) {
+		store.coalesce(grid, PICKUP_MERGE_RADIUS, gridCandidates);
+	}
+
+	// Anything inside the pickup range starts flying to the player...
+	grid.query(playerPos, magnetRange, gridCandidates);
+	for (int index : gridCandidates) {
+		if (!store.isAlive(index) || store.isMagnetized(index)) continue;
+		Vector2 offset = store.getPosition(index) - playerPos;
+		if (offset.x * offset.x + offset.y * offset.y <= magnetRangeSq) {
+			store.magnetize(index);
 		}
 	}
-}
 
-void Game::updateMaterialCollection() {
-	Vector2 playerPos = player->getPosition();
-	float pickupRange = player->getStats().pickupRange;
-
-	for (auto& material : materials) {
-		if (material->isAlive()) {
-			float distance = playerPos.distance(material->getPosition());
-			if (distance <= pickupRange) {
-				// Materials provide both experience and gold/materials
-				player->gainExperience(material->getExperienceValue());
-				player->gainMaterials(material->getMaterialValue());
-				material->collect();
-			}
+	// ...and is collected once it arrives
+	grid.query(playerPos, collectRange, gridCandidates);
+	for (int index : gridCandidates) {
+		if (!store.isAlive(index) || !store.isMagnetized(index)) continue;
+		Vector2 offset = store.getPosition(index) - playerPos;
+		if (offset.x * offset.x + offset.y * offset.y <= collectRangeSq) {
+			events.pickups.push_back({ store.getKind(), index });
 		}
 	}
 }
@@ -395,36 +626,44 @@ float Game::getMaterialDropChance() const {
 	return dropChance;
 }
 
-void Game::render() {
+void Game::render(float alpha) {
+	PROFILE_SCOPE("Game::render");
 	SDL_SetRenderDrawColor(renderer, 120, 110, 100, 255); // Light brown/tan background for better visibility
 	SDL_RenderClear(renderer);
 
-	player->render(renderer);
-	player->renderWeapons(renderer);
+	// The world is queued into the sprite batch and drawn in a few
+	// SDL_RenderGeometry calls; the UI and shop below draw immediately on top
+	SpriteBatch& batch = SpriteBatch::instance();
+	batch.begin();
 
-	for (auto& bullet : bullets) {
-		bullet->render(renderer);
-	}
+	batch.setLayer(RenderLayer::PLAYER);
+	player->render(renderer, alpha);
+	batch.setLayer(RenderLayer::WEAPONS);
+	player->renderWeapons(renderer, alpha);
+
+	batch.setLayer(RenderLayer::BULLETS);
+	bullets.renderAll(renderer, alpha);
 
+	batch.setLayer(RenderLayer::ENEMIES);
 	for (auto& enemy : enemies) {
-		enemy->render(renderer);
+		enemy->render(renderer, alpha);
 	}
 
 	// Рендер босса
+	batch.setLayer(RenderLayer::BOSS);
 	if (currentBoss) {
-		currentBoss->render(renderer);
+		currentBoss->render(renderer, alpha);
 	}
 
 	// Spawn indicators on top of background but beneath UI
+	batch.setLayer(RenderLayer::SPAWN_INDICATORS);
 	renderSpawnIndicators();
 
-	for (auto& orb : experienceOrbs) {
-		orb->render(renderer);
-	}
-
-	for (auto& material : materials) {
-		material->render(renderer);
-	}
+	batch.setLayer(RenderLayer::ORBS);
+	experienceOrbs.render(renderer, alpha);
+	batch.setLayer(RenderLayer::MATERIALS);
+	materials.render(renderer, alpha);
+	batch.setLayer(RenderLayer::BOOSTERS);
 	if (speedUpBooster) {
 		speedUpBooster->render(renderer);
 	}
@@ -432,174 +671,258 @@ void Game::render() {
 		healingBooster->render(renderer);
 	}
 
+	batch.flush();
+
 	renderUI();
 
 	// Render shop on top if active
-	shop->render(renderer, WINDOW_WIDTH, WINDOW_HEIGHT);
+	{
+		PROFILE_SCOPE("Shop::render");
+		shop->render(renderer, WINDOW_WIDTH, WINDOW_HEIGHT);
+	}
+
+	if (showProfilerOverlay) {
+		renderProfilerOverlay();
+	}
 
 	SDL_RenderPresent(renderer);
 }
 
+void Game::renderProfilerOverlay() {
+	PROFILE_SCOPE("Game::renderProfilerOverlay");
+	Profiler::instance().collectStats(profilerStats);
+
+	const int panelWidth = 560;
+	const int rowHeight = 18;
+	const int panelX = WINDOW_WIDTH - panelWidth - 20;
+	const int panelY = 140;
+	int panelHeight = (static_cast<int>(profilerStats.size()) + 5) * rowHeight + 20;
+
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200); // Semi-transparent black
+	SDL_Rect panel = { panelX, panelY, panelWidth, panelHeight };
+	SDL_RenderFillRect(renderer, &panel);
+	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White border
+	SDL_RenderDrawRect(renderer, &panel);
+
+	// Names are static labels; values are numeric-only strings so they come from the glyph atlas
+	const SDL_Color white = { 255, 255, 255, 255 };
+	const SDL_Color gray = { 170, 170, 170, 255 };
+	const int nameX = panelX + 10;
+	const int columnX[] = { panelX + 300, panelX + 370, panelX + 440, panelX + 510 };
+	char value[32];
+
+	int y = panelY + 10;
+	renderTTFText("SECTION (ms)", nameX, y, gray, 12);
+	renderTTFText("AVG", columnX[0], y, gray, 12);
+	renderTTFText("MIN", columnX[1], y, gray, 12);
+	renderTTFText("P99", columnX[2], y, gray, 12);
+	renderTTFText("CALLS", columnX[3], y, gray, 12);
+	y += rowHeight;
+
+	for (const auto& section : profilerStats) {
+		renderTTFText(section.name, nameX, y, white, 12);
+		snprintf(value, sizeof(value), "%.2f", section.avgMs);
+		renderTTFText(value, columnX[0], y, white, 12);
+		snprintf(value, sizeof(value), "%.2f", section.minMs);
+		renderTTFText(value, columnX[1], y, white, 12);
+		snprintf(value, sizeof(value), "%.2f", section.p99Ms);
+		renderTTFText(value, columnX[2], y, white, 12);
+		snprintf(value, sizeof(value), "%d", section.calls);
+		renderTTFText(value, columnX[3], y, white, 12);
+		y += rowHeight;
+	}
+
+	y += rowHeight / 2;
+	const char* countNames[] = { "BULLETS", "ENEMIES", "ORBS", "MATERIALS" };
+	EntityCounts entityCounts = getEntityCounts();
+	int counts[] = { entityCounts.bullets, entityCounts.enemies, entityCounts.orbs, entityCounts.materials };
+	for (int i = 0; i < 4; ++i) {
+		int x = nameX + i * 135;
+		renderTTFText(countNames[i], x, y, gray, 12);
+		snprintf(value, sizeof(value), "%d", counts[i]);
+		renderTTFText(value, x + 75, y, white, 12);
+	}
+
+	y += rowHeight;
+	const SpriteBatch& batch = SpriteBatch::instance();
+	renderTTFText("QUADS", nameX, y, gray, 12);
+	snprintf(value, sizeof(value), "%d", batch.getLastQuadCount());
+	renderTTFText(value, nameX + 75, y, white, 12);
+	renderTTFText("DRAW CALLS", nameX + 135, y, gray, 12);
+	snprintf(value, sizeof(value), "%d", batch.getLastDrawCalls());
+	renderTTFText(value, nameX + 235, y, white, 12);
+}
+
 void Game::renderUI() {
+	PROFILE_SCOPE("Game::renderUI");
 	// === BROTATO-STYLE UI LAYOUT WITH BITMAP TEXT ===
+	// Every widget is cached by the HUD layer and redrawn only when the values
+	// passed to beginRedraw change; x/y is where the widget's top-left goes.
+	int x, y;
+	char text[64];
 
 	// Top-left: Health bar with actual numbers
-	SDL_SetRenderDrawColor(renderer, 139, 0, 0, 255); // Dark red background
-	SDL_Rect healthBg = { 20, 20, 200, 35 };
-	SDL_RenderFillRect(renderer, &healthBg);
+	int health = player->getHealth();
+	int maxHealth = player->getStats().maxHealth;
+	if (hud.beginRedraw(HudWidget::HEALTH, { 20, 20, 200, 35 }, { health, maxHealth }, x, y)) {
+		SDL_SetRenderDrawColor(renderer, 139, 0, 0, 255); // Dark red background
+		SDL_Rect healthBg = { x, y, 200, 35 };
+		SDL_RenderFillRect(renderer, &healthBg);
 
-	SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red health bar
-	int healthWidth = (player->getHealth() * 200) / player->getStats().maxHealth;
-	SDL_Rect healthBar = { 20, 20, healthWidth, 35 };
-	SDL_RenderFillRect(renderer, &healthBar);
+		SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red health bar
+		SDL_Rect healthBar = { x, y, (health * 200) / maxHealth, 35 };
+		SDL_RenderFillRect(renderer, &healthBar);
 
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White border
-	SDL_RenderDrawRect(renderer, &healthBg);
+		SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White border
+		SDL_RenderDrawRect(renderer, &healthBg);
 
-	// Health text "X / Y"
-	renderNumber(player->getHealth(), 30, 28, 2);
-	renderText(" / ", 30 + std::to_string(player->getHealth()).length() * 12, 28, 2);
-	renderNumber(player->getStats().maxHealth, 30 + std::to_string(player->getHealth()).length() * 12 + 24, 28, 2);
+		// Health text "X /Y"
+		snprintf(text, sizeof(text), "%d /%d", health, maxHealth);
+		renderText(text, x + 10, y + 8, 2);
+		hud.endRedraw();
+	}
+	hud.present(HudWidget::HEALTH);
 
 	// Top-left: Level display "LV.X"
-	SDL_SetRenderDrawColor(renderer, 64, 64, 64, 255); // Dark gray background
-	SDL_Rect levelBg = { 20, 65, 120, 30 };
-	SDL_RenderFillRect(renderer, &levelBg);
+	int level = player->getLevel();
+	if (hud.beginRedraw(HudWidget::LEVEL, { 20, 65, 120, 30 }, { level }, x, y)) {
+		SDL_SetRenderDrawColor(renderer, 64, 64, 64, 255); // Dark gray background
+		SDL_Rect levelBg = { x, y, 120, 30 };
+		SDL_RenderFillRect(renderer, &levelBg);
 
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White border
-	SDL_RenderDrawRect(renderer, &levelBg);
+		SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White border
+		SDL_RenderDrawRect(renderer, &levelBg);
 
-	// Level text
-	renderText("LV.", 30, 72, 2);
-	renderNumber(player->getLevel(), 54, 72, 2);
+		// Level text
+		renderText("LV.", x + 10, y + 7, 2);
+		renderNumber(level, x + 34, y + 7, 2);
+		hud.endRedraw();
+	}
+	hud.present(HudWidget::LEVEL);
 
 	// Top-left: Materials counter (green circle with actual number)
-	SDL_SetRenderDrawColor(renderer, 0, 100, 0, 255); // Dark green
-	// Draw circle
-	for (int x = -40; x <= 40; x++) {
-		for (int y = -40; y <= 40; y++) {
-			if (x * x + y * y <= 40 * 40) {
-				SDL_RenderDrawPoint(renderer, 70 + x, 150 + y);
-			}
-		}
-	}
+	int materials = player->getStats().materials;
+	if (hud.beginRedraw(HudWidget::MATERIALS, { 30, 110, 81, 81 }, { materials }, x, y)) {
+		PrimitiveCache::instance().drawCircle(x + 40, y + 40, 40, { 0, 100, 0, 255 }); // Dark green
+		PrimitiveCache::instance().drawCircle(x + 40, y + 40, 35, { 50, 200, 50, 255 }); // Brighter green inner circle
 
-	SDL_SetRenderDrawColor(renderer, 50, 200, 50, 255); // Brighter green inner circle
-	for (int x = -35; x <= 35; x++) {
-		for (int y = -35; y <= 35; y++) {
-			if (x * x + y * y <= 35 * 35) {
-				SDL_RenderDrawPoint(renderer, 70 + x, 150 + y);
-			}
-		}
+		// Materials number (centered in circle)
+		snprintf(text, sizeof(text), "%d", materials);
+		renderText(text, x + 40 - BitmapFont::measure(text, 2) / 2, y + 32, 2);
+		hud.endRedraw();
 	}
-
-	// Materials number (centered in circle)
-	int materialDigits = std::to_string(player->getStats().materials).length();
-	int materialX = 70 - (materialDigits * 6); // Center the number
-	renderNumber(player->getStats().materials, materialX, 142, 2);
+	hud.present(HudWidget::MATERIALS);
 
 	// Right side: Wave number with TTF text (сдвинуто вправо)
-	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200); // Semi-transparent black
-	SDL_Rect waveBg = { WINDOW_WIDTH / 2 - 80 + 280, 20, 160, 40 }; // Сдвинуто вправо на 240px
-	SDL_RenderFillRect(renderer, &waveBg);
-
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White border
-	SDL_RenderDrawRect(renderer, &waveBg);
-
-	// Use TTF font for cleaner wave display, fallback to bitmap if TTF fails
-	if (defaultFont) {
-		SDL_Color waveColor = { 255, 255, 255, 255 };
-		std::string waveText = "WAVE " + std::to_string(wave);
-		renderTTFText(waveText.c_str(), WINDOW_WIDTH / 2 - 40 + 280, 28, waveColor, 18); // Сдвинуто вправо
-	}
-	else {
-		// Fallback to bitmap rendering with better spacing
-		renderText("WAVE", WINDOW_WIDTH / 2 - 50 + 280, 30, 2); // Сдвинуто вправо
-		renderNumber(wave, WINDOW_WIDTH / 2 + 10 + 280, 30, 2); // Сдвинуто вправо
+	bool ttf = textRenderer.isAvailable();
+	if (hud.beginRedraw(HudWidget::WAVE, { WINDOW_WIDTH / 2 - 80 + 280, 20, 160, 40 }, { wave, ttf }, x, y)) { // Сдвинуто вправо на 240px
+		SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200); // Semi-transparent black
+		SDL_Rect waveBg = { x, y, 160, 40 };
+		SDL_RenderFillRect(renderer, &waveBg);
+
+		SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White border
+		SDL_RenderDrawRect(renderer, &waveBg);
+
+		// Use TTF font for cleaner wave display, fallback to bitmap if TTF fails
+		if (ttf) {
+			snprintf(text, sizeof(text), "WAVE %d", wave);
+			renderTTFText(text, x + 40, y + 8, { 255, 255, 255, 255 }, 18);
+		}
+		else {
+			// Fallback to bitmap rendering with better spacing
+			renderText("WAVE", x + 30, y + 10, 2);
+			renderNumber(wave, x + 90, y + 10, 2);
+		}
+		hud.endRedraw();
 	}
+	hud.present(HudWidget::WAVE);
 
 	// Right side: Countdown timer with actual numbers (сдвинуто вправо)
 	float timeLeft = waveDuration - waveTimer;
 	int seconds = (int)timeLeft;
-
-	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200); // Semi-transparent black
-	SDL_Rect timerBg = { WINDOW_WIDTH / 2 - 60 + 280, 70, 120, 60 }; // Сдвинуто вправо на 240px
-	SDL_RenderFillRect(renderer, &timerBg);
-
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White border
-	SDL_RenderDrawRect(renderer, &timerBg);
-
-	// Large timer numbers using TTF (centered), fallback to bitmap
-	if (defaultFont) {
-		SDL_Color timerColor = { 255, 255, 255, 255 };
-		std::string timerText = std::to_string(seconds);
-		renderTTFText(timerText.c_str(), WINDOW_WIDTH / 2 - 15 + 280, 80, timerColor, 28); // Сдвинуто вправо
-	}
-	else {
-		// Fallback to bitmap rendering
-		int timerDigits = std::to_string(seconds).length();
-		int timerX = WINDOW_WIDTH / 2 - (timerDigits * 12) + 280; // Сдвинуто вправо
-		renderNumber(seconds, timerX, 85, 4);
+	if (hud.beginRedraw(HudWidget::TIMER, { WINDOW_WIDTH / 2 - 60 + 280, 70, 120, 60 }, { seconds, ttf }, x, y)) { // Сдвинуто вправо на 240px
+		SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200); // Semi-transparent black
+		SDL_Rect timerBg = { x, y, 120, 60 };
+		SDL_RenderFillRect(renderer, &timerBg);
+
+		SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White border
+		SDL_RenderDrawRect(renderer, &timerBg);
+
+		// Large timer numbers using TTF (centered), fallback to bitmap
+		snprintf(text, sizeof(text), "%d", seconds);
+		if (ttf) {
+			renderTTFText(text, x + 45, y + 10, { 255, 255, 255, 255 }, 28);
+		}
+		else {
+			renderText(text, x + 60 - BitmapFont::measure(text, 4) / 2, y + 15, 4);
+		}
+		hud.endRedraw();
 	}
+	hud.present(HudWidget::TIMER);
 
 	// Boss health bar (left side, at level height - only if boss exists)
 	if (currentBoss && currentBoss->isAlive()) {
 		int bossHealth = currentBoss->getHealth();
 		int bossMaxHealth = currentBoss->getMaxHealth();
 
-		// Boss health bar: 4x wider than player (800px vs 200px), 2x thinner (17px vs 35px)
-		int bossBarWidth = 800;
-		int bossBarHeight = 17;
-		int bossBarX = (WINDOW_WIDTH / 2 - bossBarWidth / 2) - 240; // Сдвинуто влево на 30%
-		int bossBarY = 65; // На высоте уровня игрока
-
-		// Dark red background
-		SDL_SetRenderDrawColor(renderer, 139, 0, 0, 255);
-		SDL_Rect bossHealthBg = { bossBarX, bossBarY, bossBarWidth, bossBarHeight };
-		SDL_RenderFillRect(renderer, &bossHealthBg);
-
-		// Boss health bar (dark orange/red for boss)
-		SDL_SetRenderDrawColor(renderer, 255, 100, 0, 255); // Orange-red for boss
-		int bossHealthWidth = (bossHealth * bossBarWidth) / bossMaxHealth;
-		SDL_Rect bossHealthBar = { bossBarX, bossBarY, bossHealthWidth, bossBarHeight };
-		SDL_RenderFillRect(renderer, &bossHealthBar);
-
-		// White border
-		SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-		SDL_RenderDrawRect(renderer, &bossHealthBg);
-
-		// Boss health text "BOSS: X / Y" (относительно позиции полоски)
-		if (defaultFont) {
-			SDL_Color bossTextColor = { 255, 255, 255, 255 };
-			std::string bossText = "BOSS: " + std::to_string(bossHealth) + " / " + std::to_string(bossMaxHealth);
-			renderTTFText(bossText.c_str(), bossBarX + bossBarWidth / 2 - 60, bossBarY - 2, bossTextColor, 14);
-		}
-		else {
-			// Fallback to bitmap rendering
-			renderText("BOSS:", bossBarX + bossBarWidth / 2 - 60, bossBarY - 2, 1);
-			renderNumber(bossHealth, bossBarX + bossBarWidth / 2 - 20, bossBarY - 2, 1);
-			renderText("/", bossBarX + bossBarWidth / 2, bossBarY - 2, 1);
-			renderNumber(bossMaxHealth, bossBarX + bossBarWidth / 2 + 15, bossBarY - 2, 1);
+		// Boss health bar: 4x wider than player (800px vs 200px), 2x thinner (17px vs 35px).
+		// The widget is a few pixels taller than the bar so the label can overhang it.
+		const int bossBarWidth = 800;
+		const int bossBarHeight = 17;
+		const int labelMargin = 4;
+		SDL_Rect bounds = { (WINDOW_WIDTH / 2 - bossBarWidth / 2) - 240, 65 - labelMargin, // Сдвинуто влево на 30%, на высоте уровня игрока
+		                    bossBarWidth, bossBarHeight + 2 * labelMargin };
+		if (hud.beginRedraw(HudWidget::BOSS_BAR, bounds, { bossHealth, bossMaxHealth, ttf }, x, y)) {
+			int bossBarX = x;
+			int bossBarY = y + labelMargin;
+
+			// Dark red background
+			SDL_SetRenderDrawColor(renderer, 139, 0, 0, 255);
+			SDL_Rect bossHealthBg = { bossBarX, bossBarY, bossBarWidth, bossBarHeight };
+			SDL_RenderFillRect(renderer, &bossHealthBg);
+
+			// Boss health bar (dark orange/red for boss)
+			SDL_SetRenderDrawColor(renderer, 255, 100, 0, 255); // Orange-red for boss
+			int bossHealthWidth = (bossHealth * bossBarWidth) / bossMaxHealth;
+			SDL_Rect bossHealthBar = { bossBarX, bossBarY, bossHealthWidth, bossBarHeight };
+			SDL_RenderFillRect(renderer, &bossHealthBar);
+
+			// White border
+			SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+			SDL_RenderDrawRect(renderer, &bossHealthBg);
+
+			// Boss health text "BOSS: X / Y" (относительно позиции полоски)
+			if (ttf) {
+				snprintf(text, sizeof(text), "BOSS: %d / %d", bossHealth, bossMaxHealth);
+				renderTTFText(text, bossBarX + bossBarWidth / 2 - 60, bossBarY - 2, { 255, 255, 255, 255 }, 14);
+			}
+			else {
+				// Fallback to bitmap rendering
+				renderText("BOSS:", bossBarX + bossBarWidth / 2 - 60, bossBarY - 2, 1);
+				renderNumber(bossHealth, bossBarX + bossBarWidth / 2 - 20, bossBarY - 2, 1);
+				renderText("/", bossBarX + bossBarWidth / 2, bossBarY - 2, 1);
+				renderNumber(bossMaxHealth, bossBarX + bossBarWidth / 2 + 15, bossBarY - 2, 1);
+			}
+			hud.endRedraw();
 		}
+		hud.present(HudWidget::BOSS_BAR);
 	}
 
 
 	// Swarm leader health bar (if exists)
-	{
-		int leaderHealth = 0;
-		int leaderMax = 0;
-		for (const auto& e : enemies) {
-			if (e->isAlive() && e->isBossUnit() && e->isLeader()) {
-				leaderHealth = e->getHealth();
-				leaderMax = e->getMaxHealth();
-				break;
-			}
-		}
-		if (leaderMax > 0) {
-			int barWidth = 700;
-			int barHeight = 14;
-			int barX = (WINDOW_WIDTH / 2 - barWidth / 2) - 240;
-			int barY = 95; // ниже полоски босса
+	const std::unique_ptr<Enemy>* leader = enemies.get(swarmLeader);
+	if (leader && (*leader)->isAlive()) {
+		int leaderHealth = (*leader)->getHealth();
+		int leaderMax = (*leader)->getMaxHealth();
+
+		const int barWidth = 700;
+		const int barHeight = 14;
+		const int labelMargin = 4;
+		SDL_Rect bounds = { (WINDOW_WIDTH / 2 - barWidth / 2) - 240, 95 - labelMargin, // ниже полоски босса
+		                    barWidth, barHeight + 2 * labelMargin };
+		if (hud.beginRedraw(HudWidget::LEADER_BAR, bounds, { leaderHealth, leaderMax, ttf }, x, y)) {
+			int barX = x;
+			int barY = y + labelMargin;
 
 			SDL_SetRenderDrawColor(renderer, 60, 0, 60, 255);
 			SDL_Rect bg = { barX, barY, barWidth, barHeight };
@@ -613,184 +936,62 @@ void Game::renderUI() {
 			SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
 			SDL_RenderDrawRect(renderer, &bg);
 
-			if (defaultFont) {
-				SDL_Color txt = { 255, 255, 255, 255 };
-				std::string t = "SWARM LEADER: " + std::to_string(leaderHealth) + " / " + std::to_string(leaderMax);
-				renderTTFText(t.c_str(), barX + barWidth / 2 - 100, barY - 2, txt, 14);
+			if (ttf) {
+				snprintf(text, sizeof(text), "SWARM LEADER: %d / %d", leaderHealth, leaderMax);
+				renderTTFText(text, barX + barWidth / 2 - 100, barY - 2, { 255, 255, 255, 255 }, 14);
 			}
+			hud.endRedraw();
 		}
+		hud.present(HudWidget::LEADER_BAR);
 	}
 
 
 	// Experience bar (bottom of screen)
-	SDL_SetRenderDrawColor(renderer, 0, 100, 0, 255); // Dark green background
-	SDL_Rect expBg = { 0, WINDOW_HEIGHT - 15, WINDOW_WIDTH, 15 };
-	SDL_RenderFillRect(renderer, &expBg);
-
-	// Experience progress (Brotato-style)
-	SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255); // Bright green
 	int expToNext = player->getExperienceToNextLevel();
 	int currentExp = player->getExperience();
 
 	// Calculate XP for current level using Brotato formula
 	int expForCurrentLevel = 0;
-	if (player->getLevel() > 1) {
-		int currentLevel = player->getLevel();
-		expForCurrentLevel = (currentLevel + 3 - 1) * (currentLevel + 3 - 1);
+	if (level > 1) {
+		expForCurrentLevel = (level + 3 - 1) * (level + 3 - 1);
 	}
 
 	int expInCurrentLevel = currentExp - expForCurrentLevel;
 	int expNeededForCurrentLevel = expToNext - expForCurrentLevel;
 
-	if (expNeededForCurrentLevel > 0) {
-		int expWidth = (expInCurrentLevel * WINDOW_WIDTH) / expNeededForCurrentLevel;
-		SDL_Rect expBar = { 0, WINDOW_HEIGHT - 15, expWidth, 15 };
-		SDL_RenderFillRect(renderer, &expBar);
+	if (hud.beginRedraw(HudWidget::EXPERIENCE_BAR, { 0, WINDOW_HEIGHT - 15, WINDOW_WIDTH, 15 },
+	                    { expInCurrentLevel, expNeededForCurrentLevel }, x, y)) {
+		SDL_SetRenderDrawColor(renderer, 0, 100, 0, 255); // Dark green background
+		SDL_Rect expBg = { x, y, WINDOW_WIDTH, 15 };
+		SDL_RenderFillRect(renderer, &expBg);
+
+		// Experience progress (Brotato-style)
+		if (expNeededForCurrentLevel > 0) {
+			SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255); // Bright green
+			int expWidth = (expInCurrentLevel * WINDOW_WIDTH) / expNeededForCurrentLevel;
+			SDL_Rect expBar = { x, y, expWidth, 15 };
+			SDL_RenderFillRect(renderer, &expBar);
+		}
+		hud.endRedraw();
 	}
+	hud.present(HudWidget::EXPERIENCE_BAR);
 }
 
 void Game::renderNumber(int number, int x, int y, int scale) {
-	// Simple 5x7 bitmap font for digits 0-9
-	static int digitPatterns[10][7] = {
-		// 0
-		{0b01110, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110},
-		// 1  
-		{0b00100, 0b01100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110},
-		// 2
-		{0b01110, 0b10001, 0b00001, 0b00110, 0b01000, 0b10000, 0b11111},
-		// 3
-		{0b01110, 0b10001, 0b00001, 0b00110, 0b00001, 0b10001, 0b01110},
-		// 4
-		{0b00010, 0b00110, 0b01010, 0b10010, 0b11111, 0b00010, 0b00010},
-		// 5
-		{0b11111, 0b10000, 0b11110, 0b00001, 0b00001, 0b10001, 0b01110},
-		// 6
-		{0b01110, 0b10001, 0b10000, 0b11110, 0b10001, 0b10001, 0b01110},
-		// 7
-		{0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b01000, 0b01000},
-		// 8
-		{0b01110, 0b10001, 0b10001, 0b01110, 0b10001, 0b10001, 0b01110},
-		// 9
-		{0b01110, 0b10001, 0b10001, 0b01111, 0b00001, 0b10001, 0b01110}
-	};
-
-	std::string numStr = std::to_string(number);
-	int currentX = x;
-
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White text
-
-	for (char c : numStr) {
-		if (c >= '0' && c <= '9') {
-			int digit = c - '0';
-
-			// Draw the digit
-			for (int row = 0; row < 7; row++) {
-				for (int col = 0; col < 5; col++) {
-					if (digitPatterns[digit][row] & (1 << (4 - col))) {
-						SDL_Rect pixel = { currentX + col * scale, y + row * scale, scale, scale };
-						SDL_RenderFillRect(renderer, &pixel);
-					}
-				}
-			}
-		}
-		currentX += 6 * scale; // Move to next digit position
-	}
+	bitmapFont.drawNumber(number, x, y, scale);
 }
 
 void Game::renderText(const char* text, int x, int y, int scale) {
-	// Simple letter patterns for common letters (5x7 bitmap)
-	static std::map<char, std::vector<int>> letterPatterns = {
-		{'A', {0b01110, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001, 0b10001}},
-		{'B', {0b11110, 0b10001, 0b10001, 0b11110, 0b10001, 0b10001, 0b11110}},
-		{'C', {0b01110, 0b10001, 0b10000, 0b10000, 0b10000, 0b10001, 0b01110}},
-		{'D', {0b11110, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b11110}},
-		{'E', {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b11111}},
-		{'F', {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b10000}},
-		{'G', {0b01110, 0b10001, 0b10000, 0b10111, 0b10001, 0b10001, 0b01110}},
-		{'H', {0b10001, 0b10001, 0b10001, 0b11111, 0b10001, 0b10001, 0b10001}},
-		{'I', {0b01110, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b01110}},
-		{'J', {0b00111, 0b00010, 0b00010, 0b00010, 0b00010, 0b10010, 0b01100}},
-		{'K', {0b10001, 0b10010, 0b10100, 0b11000, 0b10100, 0b10010, 0b10001}},
-		{'L', {0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b11111}},
-		{'M', {0b10001, 0b11011, 0b10101, 0b10101, 0b10001, 0b10001, 0b10001}},
-		{'N', {0b10001, 0b11001, 0b10101, 0b10011, 0b10001, 0b10001, 0b10001}},
-		{'O', {0b01110, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110}},
-		{'P', {0b11110, 0b10001, 0b10001, 0b11110, 0b10000, 0b10000, 0b10000}},
-		{'R', {0b11110, 0b10001, 0b10001, 0b11110, 0b10010, 0b10001, 0b10001}},
-		{'S', {0b01111, 0b10000, 0b10000, 0b01110, 0b00001, 0b00001, 0b11110}},
-		{'T', {0b11111, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100}},
-		{'U', {0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110}},
-		{'V', {0b10001, 0b10001, 0b10001, 0b10001, 0b01010, 0b01010, 0b00100}},
-		{'W', {0b10001, 0b10001, 0b10001, 0b10101, 0b10101, 0b11011, 0b10001}},
-		{'X', {0b10001, 0b01010, 0b00100, 0b00100, 0b00100, 0b01010, 0b10001}},
-		{'Y', {0b10001, 0b10001, 0b01010, 0b00100, 0b00100, 0b00100, 0b00100}},
-		{'Z', {0b11111, 0b00001, 0b00010, 0b00100, 0b01000, 0b10000, 0b11111}},
-		{'.', {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00100}},
-		{'/', {0b00001, 0b00010, 0b00010, 0b00100, 0b00100, 0b01000, 0b10000}},
-		{'|', {0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100}},
-		{'=', {0b00000, 0b00000, 0b11111, 0b00000, 0b11111, 0b00000, 0b00000}},
-		{':', {0b00000, 0b00100, 0b00000, 0b00000, 0b00000, 0b00100, 0b00000}},
-		{' ', {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000}}
-	};
-
-	int currentX = x;
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White text
-
-	for (int i = 0; text[i] != '\0'; i++) {
-		char c = text[i];
-		if (c >= '0' && c <= '9') {
-			// Handle numbers with renderNumber
-			int digit = c - '0';
-			renderNumber(digit, currentX, y, scale);
-			currentX += 6 * scale;
-		}
-		else if (letterPatterns.find(c) != letterPatterns.end()) {
-			// Draw the letter
-			auto pattern = letterPatterns[c];
-			for (int row = 0; row < 7; row++) {
-				for (int col = 0; col < 5; col++) {
-					if (pattern[row] & (1 << (4 - col))) {
-						SDL_Rect pixel = { currentX + col * scale, y + row * scale, scale, scale };
-						SDL_RenderFillRect(renderer, &pixel);
-					}
-				}
-			}
-			currentX += 6 * scale; // Move to next character position
-		}
-		else {
-			currentX += 6 * scale; // Skip unknown characters
-		}
-	}
+	bitmapFont.drawText(text, x, y, scale);
 }
 
 void Game::renderTTFText(const char* text, int x, int y, SDL_Color color, int fontSize) {
-	if (!defaultFont) return; // Fall back to bitmap rendering if no TTF font
-
-	// Create surface from text
-	SDL_Surface* textSurface = TTF_RenderText_Blended(defaultFont, text, color);
-	if (!textSurface) {
-		std::cout << "Unable to render text surface! SDL_ttf Error: " << TTF_GetError() << std::endl;
-		return;
-	}
-
-	// Create texture from surface
-	SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-	if (!textTexture) {
-		std::cout << "Unable to create texture from text! SDL Error: " << SDL_GetError() << std::endl;
-		SDL_FreeSurface(textSurface);
-		return;
-	}
-
-	// Render texture
-	SDL_Rect destRect = { x, y, textSurface->w, textSurface->h };
-	SDL_RenderCopy(renderer, textTexture, nullptr, &destRect);
-
-	// Clean up
-	SDL_FreeSurface(textSurface);
-	SDL_DestroyTexture(textTexture);
+	// Cached per (text, size, color); numbers come from a glyph atlas. No-op without a font
+	textRenderer.draw(text, x, y, color, fontSize);
 }
 
-void Game::spawnEnemies() {
+void Game::spawnEnemies(float deltaTime) {
+	PROFILE_SCOPE("Game::spawnEnemies");
 
 	// Волны >= 2: одновременно управляем большим боссом (случайный тип) и роем минибоссов
 	if (wave >= 2) {
@@ -808,19 +1009,19 @@ void Game::spawnEnemies() {
 
 			switch (chosenBossType) {
 			case BossType::FRACTAL:
-				currentBoss = CreateFractalBoss(bossSpawnPos, renderer);
+				currentBoss = CreateFractalBoss(bossSpawnPos);
 				lastBossType = BossType::FRACTAL;
-				std::cout << "Fractal Boss spawned at wave " << wave << "!" << std::endl;
+				LOG_INFO(LogCategory::SPAWN, "Fractal Boss spawned at wave %d!", wave);
 				break;
 			case BossType::CENTIPEDE:
-				currentBoss = CreateCentipedeEnemy(bossSpawnPos, renderer);
+				currentBoss = CreateCentipedeEnemy(bossSpawnPos);
 				lastBossType = BossType::CENTIPEDE;
-				std::cout << "Centipede Boss spawned at wave " << wave << "!" << std::endl;
+				LOG_INFO(LogCategory::SPAWN, "Centipede Boss spawned at wave %d!", wave);
 				break;
 			default:
-				currentBoss = CreateBossEnemy(bossSpawnPos, renderer);
+				currentBoss = CreateBossEnemy(bossSpawnPos);
 				lastBossType = BossType::REGULAR;
-				std::cout << "Regular Boss spawned at wave " << wave << "!" << std::endl;
+				LOG_INFO(LogCategory::SPAWN, "Regular Boss spawned at wave %d!", wave);
 				break;
 			}
 			bossSpawnedThisWave = true;
@@ -842,7 +1043,7 @@ void Game::spawnEnemies() {
 				spawnIndicators.emplace_back(spawnPositions[i], telegraphDuration, EnemySpawnType::MINIBOSS);
 			}
 			swarmSpawnedThisWave = true;
-			std::cout << "Swarm indicators queued!" << std::endl;
+			LOG_DEBUG(LogCategory::SPAWN, "Swarm indicators queued!");
 		}
 	}
 
@@ -855,7 +1056,7 @@ void Game::spawnEnemies() {
 	}
 
 
-	timeSinceLastSpawn += 0.016f;
+	timeSinceLastSpawn += deltaTime;
 
 	float spawnRate = 1.0f - (wave * 0.1f);
 	if (spawnRate < 0.2f) spawnRate = 0.2f;
@@ -864,17 +1065,17 @@ void Game::spawnEnemies() {
 	if (bossAlive) {
 		spawnRate *= 3.0f;
 	}
+	if (config.spawnMultiplier > 0.0f) {
+		spawnRate /= config.spawnMultiplier;
+	}
 
 	if (timeSinceLastSpawn >= spawnRate) {
 		timeSinceLastSpawn = 0;
 
-		static std::random_device rd;
-		static std::mt19937 gen(rd());
-		std::uniform_real_distribution<float> xdist(0.0f, static_cast<float>(WINDOW_WIDTH));
-		std::uniform_real_distribution<float> ydist(0.0f, static_cast<float>(WINDOW_HEIGHT));
-		std::uniform_real_distribution<float> slimeChance(0.0f, 1.0f);
-
-		Vector2 spawnPos(xdist(gen), ydist(gen));
+		Rng& gen = rng(RandomStream::SPAWN);
+		float x = gen.range(0.0f, static_cast<float>(WINDOW_WIDTH));
+		float y = gen.range(0.0f, static_cast<float>(WINDOW_HEIGHT));
+		Vector2 spawnPos(x, y);
 
 		// Queue a flashing red X indicator before actual spawn
 		float telegraphDuration = spawnTelegraphSeconds; // configurable
@@ -884,7 +1085,7 @@ void Game::spawnEnemies() {
 
 		if (wave >= 2) {
 			// From wave 2: 40% slime, 40% pebblin, 20% base
-			float typeRoll = slimeChance(gen);
+			float typeRoll = gen.nextFloat();
 			if (typeRoll < 0.4f) {
 				enemyType = EnemySpawnType::SLIME;
 			}
@@ -895,7 +1096,7 @@ void Game::spawnEnemies() {
 		}
 		else {
 			// Wave 1: 50% slime, 50% base (no pebblin yet)
-			if (slimeChance(gen) < 0.5f) {
+			if (gen.chance(0.5f)) {
 				enemyType = EnemySpawnType::SLIME;
 			}
 		}
@@ -916,10 +1117,10 @@ void Game::updateSpawnIndicators(float deltaTime) {
 		if (indicator.isComplete()) {
 			switch (indicator.enemyType) {
 			case EnemySpawnType::SLIME:
-				enemies.push_back(CreateSlimeEnemy(indicator.position, renderer));
+				enemies.emplace(CreateSlimeEnemy(indicator.position));
 				break;
 			case EnemySpawnType::PEBBLIN:
-				enemies.push_back(CreatePebblinEnemy(indicator.position, renderer));
+				enemies.emplace(CreatePebblinEnemy(indicator.position));
 				break;
 			case EnemySpawnType::BOSS:
 
@@ -928,19 +1129,19 @@ void Game::updateSpawnIndicators(float deltaTime) {
 
 					switch (chosenBossType) {
 					case BossType::FRACTAL:
-						currentBoss = CreateFractalBoss(indicator.position, renderer);
+						currentBoss = CreateFractalBoss(indicator.position);
 						lastBossType = BossType::FRACTAL;
-						std::cout << "Fractal Boss spawned via indicator!" << std::endl;
+						LOG_INFO(LogCategory::SPAWN, "Fractal Boss spawned via indicator!");
 						break;
 					case BossType::CENTIPEDE:
-						currentBoss = CreateCentipedeEnemy(indicator.position, renderer);
+						currentBoss = CreateCentipedeEnemy(indicator.position);
 						lastBossType = BossType::CENTIPEDE;
-						std::cout << "Centipede Boss spawned via indicator!" << std::endl;
+						LOG_INFO(LogCategory::SPAWN, "Centipede Boss spawned via indicator!");
 						break;
 					default:
-						currentBoss = CreateBossEnemy(indicator.position, renderer);
+						currentBoss = CreateBossEnemy(indicator.position);
 						lastBossType = BossType::REGULAR;
-						std::cout << "Regular Boss spawned via indicator!" << std::endl;
+						LOG_INFO(LogCategory::SPAWN, "Regular Boss spawned via indicator!");
 						break;
 					}
 					bossSpawnedThisWave = true;
@@ -969,14 +1170,17 @@ void Game::updateSpawnIndicators(float deltaTime) {
 				else {
 					variantIndex = 5;
 				}
-				extern std::unique_ptr<Enemy> CreateMiniBossEnemy(const Vector2 & pos, SDL_Renderer * renderer, int variantIndex, bool isLeader);
-				enemies.push_back(CreateMiniBossEnemy(indicator.position, renderer, variantIndex, isLeader));
+				extern std::unique_ptr<Enemy> CreateMiniBossEnemy(const Vector2 & pos, int variantIndex, bool isLeader);
+				SlotHandle handle = enemies.emplace(CreateMiniBossEnemy(indicator.position, variantIndex, isLeader));
+				if (isLeader) {
+					swarmLeader = handle;
+				}
 
 			}
 			break;
 			case EnemySpawnType::BASE:
 			default:
-				enemies.push_back(std::make_unique<Enemy>(indicator.position, renderer));
+				enemies.emplace(std::make_unique<Enemy>(indicator.position));
 				break;
 			}
 		}
@@ -988,62 +1192,89 @@ void Game::updateSpawnIndicators(float deltaTime) {
 }
 
 void Game::renderSpawnIndicators() {
+	SpriteBatch& batch = SpriteBatch::instance();
 	for (auto& indicator : spawnIndicators) {
 		// Flashing red X effect, fades in/out over duration
 		float t = indicator.elapsed;
 		float flash = fmodf(t * 6.0f, 2.0f) < 1.0f ? 255.0f : 80.0f; // blink ~3 Hz
-		Uint8 alpha = static_cast<Uint8>(flash);
-		SDL_SetRenderDrawColor(renderer, 200, 0, 0, alpha);
+		SDL_Color color = { 200, 0, 0, static_cast<Uint8>(flash) };
 
 		int size = 14; // cross arm length
 		int cx = static_cast<int>(indicator.position.x);
 		int cy = static_cast<int>(indicator.position.y);
 		// 4 short lines to make an X
 		for (int i = -size; i <= size; ++i) {
-			SDL_RenderDrawPoint(renderer, cx + i, cy + i);
-			SDL_RenderDrawPoint(renderer, cx + i, cy - i);
+			batch.drawPoint(cx + i, cy + i, color);
+			batch.drawPoint(cx + i, cy - i, color);
 		}
 	}
 }
 
+void Game::rebuildEnemyGrid() {
+	PROFILE_SCOPE("Game::rebuildEnemyGrid");
+	// Enemies are not added or removed until the cleanup at the end of update(),
+	// so indices stay valid for every query made this tick
+	enemyGrid.clear();
+	for (size_t i = 0; i < enemies.size(); ++i) {
+		if (enemies[i]->isAlive()) {
+			enemyGrid.insert((int)i, enemies[i]->getPosition(), enemies[i]->getRadius());
+		}
+	}
+	enemyGrid.build();
+}
+
+// True if the circles overlap; squared so the hot loops skip sqrt
+static bool circlesOverlap(const Vector2& a, float radiusA, const Vector2& b, float radiusB) {
+	Vector2 offset = a - b;
+	float reach = radiusA + radiusB;
+	return offset.x * offset.x + offset.y * offset.y < reach * reach;
+}
+
 void Game::checkCollisions() {
-	for (auto& bullet : bullets) {
-		if (!bullet->isAlive()) continue;
-		if (bullet->isEnemyOwned()) {
+	PROFILE_SCOPE("Game::checkCollisions");
+	// Hits are queued; a pass treats an enemy whose queued damage already covers its health as dead
+	pendingDamage.assign(enemies.size(), 0);
+	killingSource.resize(enemies.size());
+
+	const float bulletRadius = bullets.getRadius();
+	for (int i = 0; i < bullets.size(); ++i) {
+		if (!bullets.isAlive(i)) continue;
+		Vector2 bulletPos = bullets.getPosition(i);
+		if (bullets.isEnemyOwned(i)) {
 			// enemy bullets damage the player
-			float d = bullet->getPosition().distance(player->getPosition());
-			if (d < bullet->getRadius() + player->getRadius()) {
-				player->takeDamage(bullet->getDamage());
-				bullet->destroy();
+			if (circlesOverlap(bulletPos, bulletRadius, player->getPosition(), player->getRadius())) {
+				player->takeDamage(bullets.getDamage(i));
+				bullets.destroy(i);
 			}
 			continue;
 		}
-		for (auto& enemy : enemies) {
-			if (bullet->isAlive() && enemy->isAlive()) {
-				float distance = bullet->getPosition().distance(enemy->getPosition());
-				if (distance < bullet->getRadius() + enemy->getRadius()) {
-					bullet->destroy();
-					enemy->takeDamage(bullet->getDamage());
+		enemyGrid.query(bulletPos, bulletRadius, gridCandidates);
+		for (int index : gridCandidates) {
+			auto& enemy = enemies[index];
+			// Enemies already doomed this tick let the bullet fly on
+			if (bullets.isAlive(i) && isEnemyStanding(index)) {
+				if (circlesOverlap(bulletPos, bulletRadius, enemy->getPosition(), enemy->getRadius())) {
+					bullets.destroy(i);
+					queueEnemyDamage(index, bullets.getDamage(i), DamageSource::BULLET);
 				}
 			}
 		}
 
 		// Коллизии с боссом
-		if (bullet->isAlive() && currentBoss && currentBoss->isAlive()) {
-			float distance = bullet->getPosition().distance(currentBoss->getPosition());
-			if (distance < bullet->getRadius() + currentBoss->getRadius()) {
-				bullet->destroy();
-				currentBoss->takeDamage(bullet->getDamage());
+		if (bullets.isAlive(i) && currentBoss && currentBoss->isAlive()) {
+			if (currentBoss->takeDamageAt(bulletPos, bulletRadius, bullets.getDamage(i))) {
+				bullets.destroy(i);
 			}
 		}
 	}
 
-	for (auto& enemy : enemies) {
-		if (enemy->isAlive()) {
-			float distance = player->getPosition().distance(enemy->getPosition());
-			if (distance < player->getRadius() + enemy->getRadius()) {
+	enemyGrid.query(player->getPosition(), player->getRadius(), gridCandidates);
+	for (int index : gridCandidates) {
+		auto& enemy = enemies[index];
+		if (isEnemyStanding(index)) {
+			if (circlesOverlap(player->getPosition(), player->getRadius(), enemy->getPosition(), enemy->getRadius())) {
 				player->takeDamage(enemy->getDamage());
-				enemy->destroy();
+				queueEnemyDamage(index, enemy->getHealth() - pendingDamage[index], DamageSource::CONTACT);
 			}
 		}
 	}
@@ -1059,6 +1290,7 @@ void Game::checkCollisions() {
 }
 
 void Game::checkMeleeAttacks() {
+	PROFILE_SCOPE("Game::checkMeleeAttacks");
 	// Check if player has any melee weapons that are currently attacking
 	for (int i = 0; i < player->getWeaponCount(); i++) {
 		const Weapon* weapon = player->getWeapon(i);
@@ -1069,19 +1301,17 @@ void Game::checkMeleeAttacks() {
 			Vector2 brickPos = weapon->getOrbitingPosition(center);
 			float hitR = weapon->getOrbitingRadius();
 			int damage = weapon->calculateDamage(*player);
-			for (auto& enemy : enemies) {
-				if (!enemy->isAlive()) continue;
-				float d = brickPos.distance(enemy->getPosition());
-				if (d <= hitR + enemy->getRadius()) {
-					enemy->takeDamage(damage);
-					// опыт и материалы, как в ближнем бою
-					experienceOrbs.push_back(std::make_unique<ExperienceOrb>(enemy->getPosition()));
-					static std::random_device matRd;
-					static std::mt19937 matGen(matRd());
-					std::uniform_real_distribution<float> matChance(0.0f, 1.0f);
-					if (matChance(matGen) < getMaterialDropChance()) {
-						materials.push_back(std::make_unique<Material>(enemy->getPosition()));
-					}
+			float hitCooldown = weapon->getOrbitingHitCooldown();
+			enemyGrid.query(brickPos, hitR, gridCandidates);
+			for (int index : gridCandidates) {
+				auto& enemy = enemies[index];
+				if (!isEnemyStanding(index)) continue;
+				Vector2 offset = enemy->getPosition() - brickPos;
+				float reach = hitR + enemy->getRadius();
+				if (offset.x * offset.x + offset.y * offset.y <= reach * reach
+					&& contactCooldowns.tryHit(i, enemies.handleAt(index), combatTime, hitCooldown)) {
+					// Drops come from the kill (processDeathEvents), not from every touch
+					queueEnemyDamage(index, damage, DamageSource::ORBIT);
 				}
 			}
 		}
@@ -1098,53 +1328,164 @@ void Game::checkMeleeAttacks() {
 			int meleeDamage = weapon->calculateDamage(*player);
 
 			// Check for critical hit
-			static std::random_device rd;
-			static std::mt19937 gen(rd());
-			std::uniform_real_distribution<float> critRoll(0.0f, 1.0f);
-
-			if (critRoll(gen) < weapon->getStats().critChance) {
+			if (rng(RandomStream::COMBAT).chance(weapon->getStats().critChance)) {
 				meleeDamage = (int)(meleeDamage * weapon->getStats().critMultiplier);
 			}
 
 			// Damage all enemies within damage radius of weapon tip (Brotato-style infinite pierce)
-			for (auto& enemy : enemies) {
-				if (enemy->isAlive()) {
-					float distance = weaponTip.distance(enemy->getPosition());
-					if (distance <= damageRadius + enemy->getRadius()) {
-						enemy->takeDamage(meleeDamage);
-
-						// Create experience orb at enemy position
-						experienceOrbs.push_back(std::make_unique<ExperienceOrb>(enemy->getPosition()));
-
-						// Chance to drop materials
-						static std::random_device matRd;
-						static std::mt19937 matGen(matRd());
-						std::uniform_real_distribution<float> matChance(0.0f, 1.0f);
-
-						if (matChance(matGen) < getMaterialDropChance()) {
-							materials.push_back(std::make_unique<Material>(enemy->getPosition()));
-						}
+			enemyGrid.query(weaponTip, damageRadius, gridCandidates);
+			for (int index : gridCandidates) {
+				auto& enemy = enemies[index];
+				if (isEnemyStanding(index)) {
+					Vector2 offset = enemy->getPosition() - weaponTip;
+					float reach = damageRadius + enemy->getRadius();
+					if (offset.x * offset.x + offset.y * offset.y <= reach * reach) {
+						queueEnemyDamage(index, meleeDamage, DamageSource::MELEE);
+
+						// Experience orb at enemy position, plus a chance of materials
+						events.drops.push_back({ enemy->getPosition(), DropKind::EXPERIENCE_ORB, 1.0f, 0, 1 });
+						events.drops.push_back({ enemy->getPosition(), DropKind::MATERIAL, getMaterialDropChance(), 1, 1 });
 					}
 				}
 			}
 
 			// Мелее атаки по боссу
 			if (currentBoss && currentBoss->isAlive()) {
-				float distance = weaponTip.distance(currentBoss->getPosition());
-				if (distance <= damageRadius + currentBoss->getRadius()) {
-					currentBoss->takeDamage(meleeDamage);
-				}
+				currentBoss->takeDamageAt(weaponTip, damageRadius, meleeDamage);
 			}
 		}
 	}
 }
 
+void Game::queueEnemyDamage(int enemy, int amount, DamageSource source) {
+	events.damage.push_back({ enemy, amount, source });
+	int queued = pendingDamage[enemy];
+	pendingDamage[enemy] += amount;
+	// The death is credited to the hit that first covers the enemy's health;
+	// the tick's first hit stands in until then
+	int health = enemies[enemy]->getHealth();
+	if (queued == 0 || (queued < health && pendingDamage[enemy] >= health)) {
+		killingSource[enemy] = source;
+	}
+}
+
+bool Game::isEnemyStanding(int enemy) const {
+	return enemies[enemy]->isAlive() && pendingDamage[enemy] < enemies[enemy]->getHealth();
+}
+
+void Game::processDamageEvents() {
+	PROFILE_SCOPE("Game::processDamageEvents");
+	// Every hit on an enemy this tick lands as one takeDamage with the summed amount
+	for (const DamageEvent& hit : events.damage) {
+		int total = pendingDamage[hit.enemy];
+		if (total == 0) continue; // merged into an earlier event
+		pendingDamage[hit.enemy] = 0;
+
+		auto& enemy = enemies[hit.enemy];
+		if (!enemy->isAlive()) continue;
+		enemy->takeDamage(total);
+		if (!enemy->isAlive()) {
+			events.deaths.push_back({ enemy->getPosition(), killingSource[hit.enemy] });
+		}
+	}
+	events.damage.clear();
+}
+
+void Game::processDeathEvents() {
+	// Brotato-style material drop system
+	float dropChance = getMaterialDropChance();
+	int matValue = 1 + (wave / 3);
+	int expValue = 1 + (wave / 5);
+	for (const DeathEvent& death : events.deaths) {
+		score += 10;
+		// Orbiting-brick kills also leave the experience orb its hits no longer drop
+		if (death.cause == DamageSource::ORBIT) {
+			events.drops.push_back({ death.position, DropKind::EXPERIENCE_ORB, 1.0f, 0, 1 });
+		}
+		events.drops.push_back({ death.position, DropKind::MATERIAL, dropChance, matValue, expValue });
+	}
+	events.deaths.clear();
+}
+
+void Game::processDropEvents() {
+	PROFILE_SCOPE("Game::processDropEvents");
+	Rng& drops = rng(RandomStream::DROPS);
+	for (const DropEvent& drop : events.drops) {
+		if (drop.chance < 1.0f && !drops.chance(drop.chance)) continue;
+
+		// No cap here: crowded stores coalesce instead
+		if (drop.kind == DropKind::EXPERIENCE_ORB) {
+			experienceOrbs.spawn(drop.position, drop.experienceValue, 0);
+		} else {
+			materials.spawn(drop.position, drop.experienceValue, drop.materialValue);
+		}
+	}
+	events.drops.clear();
+}
+
+void Game::processPickupEvents() {
+	for (const PickupEvent& pickup : events.pickups) {
+		PickupStore& store = pickup.kind == PickupKind::EXPERIENCE_ORB ? experienceOrbs : materials;
+		if (!store.isAlive(pickup.index)) continue;
+		// Materials provide both experience and gold/materials
+		player->gainExperience(store.getExperienceValue(pickup.index));
+		if (pickup.kind == PickupKind::MATERIAL) {
+			player->gainMaterials(store.getMaterialValue(pickup.index));
+		}
+		store.collect(pickup.index);
+	}
+	events.pickups.clear();
+}
+
 void Game::cleanup() {
-	if (defaultFont) {
-		TTF_CloseFont(defaultFont);
-		defaultFont = nullptr;
+	// Entities hand their texture references back before the cache is torn down
+	enemies.clear();
+	swarmLeader = SlotHandle();
+	currentBoss.reset();
+	speedUpBooster.reset();
+	healingBooster.reset();
+	shop.reset();
+	player.reset();
+
+	JobSystem::instance().shutdown();
+
+	// Drain queued log messages; the exit summaries below then print in order
+	Logger::instance().shutdown();
+
+#ifdef BROTATO_PROFILING
+	Profiler::instance().logSummary();
+#endif
+
+	TextureCache& textureCache = TextureCache::instance();
+	if (renderer) {
+		textureCache.logStats();
+	}
+	textureCache.clear();
+	PrimitiveCache::instance().clear();
+	SpriteBatch::instance().clear();
+
+	if (replayWriter.isOpen()) {
+		replayWriter.close();
+		LOG_INFO(LogCategory::GAME, "Recorded %u ticks to %s (%ld bytes)", replayWriter.getTickCount(),
+			config.recordPath.c_str(), replayWriter.getByteCount());
+	}
+	if (replayReader.isOpen()) {
+		if (replayReader.hasDiverged()) {
+			LOG_WARN(LogCategory::GAME, "Replay diverged at tick %u; %d checksums matched before that",
+				replayReader.getDivergedTick(), replayReader.getVerifiedCount());
+		} else {
+			LOG_INFO(LogCategory::GAME, "Replay matched the recording at all %d checksums", replayReader.getVerifiedCount());
+		}
 	}
 
+	if (renderer) {
+		textRenderer.logStats();
+		LOG_INFO(LogCategory::GAME, "HUD: %d widget redraws", hud.getRedrawCount());
+	}
+	textRenderer.clear();
+	bitmapFont.clear();
+	hud.clear();
+
 	if (renderer) {
 		SDL_DestroyRenderer(renderer);
 		renderer = nullptr;
@@ -1155,16 +1496,16 @@ void Game::cleanup() {
 		window = nullptr;
 	}
 
-	TTF_Quit();
-	IMG_Quit();
+	if (!config.headless) {
+		TTF_Quit();
+		IMG_Quit();
+	}
 	SDL_Quit();
 }
 
 // Boss spawning helper function
 Game::BossType Game::chooseBossType() const {
-	static std::random_device rd;
-	static std::mt19937 gen(rd());
-	std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+	Rng& gen = rng(RandomStream::SPAWN);
 
 	// Создаем список доступных типов боссов (исключая тот, что был в прошлый раз)
 	std::vector<BossType> availableTypes;
@@ -1191,7 +1532,7 @@ Game::BossType Game::chooseBossType() const {
 			fractalChance = 0.6f;  // 60%
 		}
 		*/
-		if (dis(gen) < fractalChance) {
+		if (gen.chance(fractalChance)) {
 			availableTypes.push_back(BossType::FRACTAL);
 		}
 	}
@@ -1204,8 +1545,7 @@ Game::BossType Game::chooseBossType() const {
 	}
 
 	// Выбираем случайный тип из доступных
-	std::uniform_int_distribution<size_t> indexDis(0, availableTypes.size() - 1);
-	return availableTypes[indexDis(gen)];
+	return availableTypes[gen.rangeInt(0, (int)availableTypes.size() - 1)];
 }
 
 // Для обратной совместимости
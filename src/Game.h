@@ -3,15 +3,24 @@
 #include <SDL2/SDL_ttf.h>
 #include <vector>
 #include <memory>
+#include <string>
 #include "Player.h"
 #include "Enemy.h"
-#include "Bullet.h"
-#include "ExperienceOrb.h"
-#include "Material.h"
+#include "BulletPool.h"
+#include "PickupStore.h"
 #include "Weapon.h"
 #include "Shop.h"
 #include "SpeedUpBooster.h"
 #include "HealingBooster.h"
+#include "SpatialGrid.h"
+#include "SlotMap.h"
+#include "GameEvents.h"
+#include "HitCooldownTable.h"
+#include "TextRenderer.h"
+#include "BitmapFont.h"
+#include "HudLayer.h"
+#include "InputReplay.h"
+#include "Profiler.h"
 
 // Forward declarations
 class SlimeEnemy;
@@ -41,36 +50,109 @@ struct SpawnIndicator {
     bool isComplete() const { return elapsed >= duration; }
 };
 
+struct GameConfig {
+    // Simulation only: no window, renderer, images or fonts are created
+    bool headless = false;
+    bool fullscreen = true;
+    // Close the between-wave shop immediately (nobody can click it headless)
+    bool autoCloseShop = false;
+    // Simulation ticks per second; rendering is decoupled and interpolated
+    int tickRate = 60;
+    // Without vsync the renderer runs uncapped
+    bool vsync = true;
+    // Master seed for every random stream; 0 picks one at startup (printed so the run can be replayed)
+    uint64_t seed = 0;
+    // Scales how often regular enemies spawn (benchmarks push it above 1)
+    float spawnMultiplier = 1.0f;
+    // SDL's software renderer instead of the GPU one
+    bool softwareRenderer = false;
+    // Job system threads for entity updates; -1 = one per spare core, 0 = main thread only
+    int workerThreads = -1;
+    // Write every tick's input to this replay file
+    std::string recordPath;
+    // Play this replay file instead of reading the keyboard and mouse; its seed,
+    // tick rate and spawn settings replace the ones above
+    std::string replayPath;
+};
+
+// Player input for one tick when the game is driven by code instead of SDL events
+struct GameInput {
+    Vector2 move;      // each axis in -1..1
+    Vector2 aimTarget; // weapons face this point
+};
+
+struct EntityCounts {
+    int enemies;
+    int bullets;
+    int orbs;
+    int materials;
+};
+
 class Game {
 public:
     Game();
     ~Game();
     
-    bool init();
+    bool init(const GameConfig& gameConfig = GameConfig());
     void run();
     void cleanup();
     
+    // Advance the simulation by one update without touching SDL input or video
+    void step(float deltaTime) { update(deltaTime); }
+    // Draw and present one frame (needs a renderer, so not in headless mode)
+    void renderFrame(float alpha) { render(alpha); }
+    // Replaces keyboard and mouse input for the next step(); ignored while the shop is open
+    void applyInput(const GameInput& input);
+    bool isRunning() const { return running; }
+    bool isHeadless() const { return config.headless; }
+    int getWave() const { return wave; }
+    int getScore() const { return score; }
+    EntityCounts getEntityCounts() const;
+    const SlotMap<std::unique_ptr<Enemy>>& getEnemies() const { return enemies; }
+    // Handles stay valid across frames and resolve to nullptr once the entity is gone
+    SlotHandle getEnemyHandle(size_t index) const { return enemies.handleAt(index); }
+    Enemy* findEnemy(SlotHandle handle) const;
+    
     void renderNumber(int number, int x, int y, int scale = 1);
     void renderText(const char* text, int x, int y, int scale = 1);
     void renderTTFText(const char* text, int x, int y, SDL_Color color, int fontSize = 16);
     int getPlayerMaterials() const { return player ? player->getStats().materials : 0; }
     const Player* getPlayer() const { return player.get(); }
     SDL_Renderer* getRenderer() const { return renderer; }
+    const SpatialGrid& getEnemyGrid() const { return enemyGrid; }
     
 private:
+    bool initHeadless();
+    void initWorld();
     void handleEvents();
+    // One fixed step of the main loop: feeds this tick's input (live, or from the replay) and updates
+    void tick(float deltaTime);
+    void applyInputFrame(const InputFrame& input);
+    // Hash of the state a replay checks for divergence
+    uint32_t stateChecksum() const;
     void update(float deltaTime);
-    void render();
-    void spawnEnemies();
+    void render(float alpha);
+    void storePreviousPositions();
+    void spawnEnemies(float deltaTime);
     void updateSpawnIndicators(float deltaTime);
     void renderSpawnIndicators();
+    void rebuildEnemyGrid();
     void checkCollisions();
     void checkMeleeAttacks();
-    void updateExperienceCollection();
-    void updateMaterialCollection();
+    // Coalesces a crowded store, magnetizes pickups in range and queues the ones that reached the player
+    void updatePickupCollection(PickupStore& store, SpatialGrid& grid, int coalesceThreshold);
+    // Event systems, run in this order after the passes above
+    void processDamageEvents();
+    void processDeathEvents();
+    void processDropEvents();
+    void processPickupEvents();
+    void queueEnemyDamage(int enemy, int amount, DamageSource source);
+    // Alive and not already killed by damage queued this tick
+    bool isEnemyStanding(int enemy) const;
     void updateBoosterCollection();
     float getMaterialDropChance() const;
     void renderUI();
+    void renderProfilerOverlay();
     
     // Boss types enum
     enum class BossType {
@@ -88,13 +170,16 @@ private:
     BossType lastBossType;
     
 private:
+    GameConfig config;
     SDL_Window* window;
     SDL_Renderer* renderer;
     bool running;
     
     std::unique_ptr<Player> player;
-    std::vector<std::unique_ptr<Enemy>> enemies;
-    std::vector<std::unique_ptr<Bullet>> bullets;
+    // Slot maps: dense iteration, O(1) spawn/despawn, generational handles
+    SlotMap<std::unique_ptr<Enemy>> enemies;
+    SlotHandle swarmLeader; // the swarm's leader for the HUD bar; stale once it dies
+    BulletPool bullets;
     
     // Босс система - только один босс за волну
     std::unique_ptr<Enemy> currentBoss;
@@ -103,8 +188,8 @@ private:
     
 
     std::vector<SpawnIndicator> spawnIndicators;
-    std::vector<std::unique_ptr<ExperienceOrb>> experienceOrbs;
-    std::vector<std::unique_ptr<Material>> materials;
+    PickupStore experienceOrbs{ PickupKind::EXPERIENCE_ORB };
+    PickupStore materials{ PickupKind::MATERIAL };
     std::unique_ptr<SpeedUpBooster> speedUpBooster; // at most one
     std::unique_ptr<HealingBooster> healingBooster; // at most one
     float boosterSpawnTimer = 0.0f; // spawns every 10 seconds
@@ -122,17 +207,63 @@ private:
     
     // Materials system (Brotato-style)
     int materialBag; // Materials stored for next wave
-    static const int MAX_MATERIALS_ON_MAP = 50;
+
+    // Past these counts, pickups within PICKUP_MERGE_RADIUS of each other merge into one
+    static const int ORB_COALESCE_THRESHOLD = 150;
+    static const int MATERIAL_COALESCE_THRESHOLD = 50;
+    static constexpr float PICKUP_MERGE_RADIUS = 40.0f;
     
     // Shop system
     std::unique_ptr<Shop> shop;
     
-    // TTF Font system
-    TTF_Font* defaultFont;
+    // F3 toggles the per-system timing overlay (empty unless built with BROTATO_PROFILING)
+    bool showProfilerOverlay = false;
+    std::vector<ProfileSectionStats> profilerStats; // reused each frame
+    
+    // TTF text with cached labels and per-size fonts
+    TextRenderer textRenderer;
+    // Built-in 5x7 pixel font behind renderText/renderNumber
+    BitmapFont bitmapFont;
+    // Cached HUD widgets, redrawn only when their values change
+    HudLayer hud;
+    
+    // Broadphase grids, rebuilt every tick before the checks that query them.
+    // Ids are dense indices into enemies and pickup store indices, valid until the end-of-tick sweep.
+    SpatialGrid enemyGrid;
+    SpatialGrid orbGrid;
+    SpatialGrid materialGrid;
+    std::vector<int> gridCandidates; // reused query buffer
+    static constexpr float COLLISION_CELL_SIZE = 64.0f;
+
+    // Combat side effects queued by the collision passes (see GameEvents.h)
+    GameEventQueue events;
+    std::vector<int> pendingDamage; // per dense enemy index, damage queued this tick
+    std::vector<DamageSource> killingSource; // per dense enemy index, the hit a death is credited to
+
+    // Orbiting weapons hit each enemy at most once per cooldown
+    HitCooldownTable contactCooldowns{ Player::MAX_WEAPONS };
+    float combatTime = 0.0f; // simulated seconds outside the shop, the cooldown clock
+
+    // Parallel entity updates. Enemy shots are recorded per chunk and flushed
+    // into the pool in chunk order, so results do not depend on thread count.
+    std::vector<BulletCommandBuffer> enemyBulletBuffers;
+    static constexpr int ENEMY_UPDATE_GRAIN = 64;
+    static constexpr int PICKUP_UPDATE_GRAIN = 256;
+    static constexpr int BULLET_UPDATE_GRAIN = 2048;
     
     // Telegraph duration for spawn indicators (seconds)
     float spawnTelegraphSeconds = 2.0f;
     
+    // Input recording and playback (see InputReplay.h)
+    InputFrame liveInput; // sampled once per rendered frame, used by every tick in it
+    ReplayWriter replayWriter;
+    ReplayReader replayReader;
+    uint32_t tickCount = 0;
+    static const uint32_t REPLAY_CHECKSUM_INTERVAL = 60; // ticks between state checksums
+    
+    // Longest real frame fed into the fixed-step accumulator
+    static constexpr double MAX_FRAME_SECONDS = 0.25;
+    
     static const int WINDOW_WIDTH = 1920;
     static const int WINDOW_HEIGHT = 1080;
 };
\ No newline at end of file
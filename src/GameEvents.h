@@ -0,0 +1,60 @@
+#pragma once
+#include <vector>
+#include "Vector2.h"
+
+// Side effects of a tick's collision passes, queued instead of applied inline.
+// The collision and collection passes only read world state and append
+// events; Game's damage, death, drop and pickup systems then drain each
+// queue in order, each in one batch. Enemy and pickup ids are dense
+// SlotMap indices, valid until the end-of-tick sweep. Damage to the player
+// and to the boss (which resolves its own node hits) is still applied inline.
+
+enum class DamageSource {
+    BULLET,
+    MELEE,
+    ORBIT,   // orbiting brick
+    CONTACT  // enemy ran into the player; always lethal
+};
+
+struct DamageEvent {
+    int enemy;
+    int amount;
+    DamageSource source;
+};
+
+struct DeathEvent {
+    Vector2 position;
+    DamageSource cause; // source of the hit whose damage first covered the enemy's health
+};
+
+enum class DropKind {
+    EXPERIENCE_ORB,
+    MATERIAL
+};
+
+struct DropEvent {
+    Vector2 position;
+    DropKind kind;
+    float chance;        // rolled on the DROPS stream; 1 = always
+    int materialValue;   // MATERIAL only
+    int experienceValue;
+};
+
+enum class PickupKind {
+    EXPERIENCE_ORB,
+    MATERIAL
+};
+
+struct PickupEvent {
+    PickupKind kind;
+    int index;
+};
+
+// One vector per event type; each system clears its queue once drained, so
+// the capacity is reused tick to tick
+struct GameEventQueue {
+    std::vector<DamageEvent> damage;
+    std::vector<DeathEvent> deaths;
+    std::vector<DropEvent> drops;
+    std::vector<PickupEvent> pickups;
+};
@@ -1,4 +1,7 @@
 #include "HealingBooster.h"
+#include "TextureCache.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
 #include <iostream>
 
 HealingBooster::HealingBooster(const Vector2& spawnPosition)
@@ -6,16 +9,10 @@ HealingBooster::HealingBooster(const Vector2& spawnPosition)
 
 HealingBooster::~HealingBooster() {}
 
-void HealingBooster::initialize(SDL_Renderer* renderer) {
-    SDL_Surface* surface = IMG_Load("assets/ui/healing_booster.png");
-    if (!surface) {
-        std::cout << "Failed to load healing_booster.png: " << IMG_GetError() << std::endl;
-        return;
-    }
-    texture = SDL_CreateTextureFromSurface(renderer, surface);
-    textureWidth = surface->w;
-    textureHeight = surface->h;
-    SDL_FreeSurface(surface);
+void HealingBooster::initialize() {
+    TextureCache& cache = TextureCache::instance();
+    texture = cache.acquire("assets/ui/healing_booster.png");
+    cache.getSize(texture, textureWidth, textureHeight);
 }
 
 void HealingBooster::update(float deltaTime) {
@@ -34,20 +31,13 @@ void HealingBooster::render(SDL_Renderer* renderer) {
         int scaledW = textureWidth;
         int scaledH = textureHeight;
         SDL_Rect dst{ static_cast<int>(position.x - scaledW / 2), static_cast<int>(position.y - scaledH / 2), scaledW, scaledH };
-        SDL_RenderCopy(renderer, texture, nullptr, &dst);
+        SpriteBatch::instance().copy(texture, nullptr, dst);
     } else {
         // Fallback: draw green cross-like circle
-        SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
         int r = static_cast<int>(radius);
         int cx = static_cast<int>(position.x);
         int cy = static_cast<int>(position.y);
-        for (int x = -r; x <= r; ++x) {
-            for (int y = -r; y <= r; ++y) {
-                if (x * x + y * y <= r * r) {
-                    SDL_RenderDrawPoint(renderer, cx + x, cy + y);
-                }
-            }
-        }
+        PrimitiveCache::instance().drawCircle(cx, cy, r, { 0, 255, 0, 255 });
     }
     
     // Render progress bar from base class
@@ -6,7 +6,7 @@ public:
     HealingBooster(const Vector2& spawnPosition);
     ~HealingBooster();
 
-    void initialize(SDL_Renderer* renderer) override;
+    void initialize() override;
     void update(float deltaTime) override;
     void render(SDL_Renderer* renderer) override;
     void collect() override;
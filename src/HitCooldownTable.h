@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "SlotMap.h"
+
+// Per-(weapon, enemy) hit cooldowns for contact weapons that touch the same
+// enemy for many ticks in a row. Indexed directly by enemy slot and weapon
+// slot, so a lookup is one array access; each entry remembers the slot
+// generation it was written for, and an entry left by a dead enemy simply
+// reads as "ready" for whatever reuses the slot.
+class HitCooldownTable {
+public:
+    explicit HitCooldownTable(int weaponSlots) : weaponSlots(weaponSlots) {}
+
+    // True if weapon may hit enemy at time now, in which case the cooldown restarts
+    bool tryHit(int weapon, SlotHandle enemy, float now, float cooldown) {
+        size_t index = static_cast<size_t>(enemy.index) * weaponSlots + weapon;
+        if (index >= entries.size()) {
+            entries.resize((static_cast<size_t>(enemy.index) + 1) * weaponSlots);
+        }
+        Entry& entry = entries[index];
+        if (entry.generation == enemy.generation && now < entry.readyAt) {
+            return false;
+        }
+        entry.generation = enemy.generation;
+        entry.readyAt = now + cooldown;
+        return true;
+    }
+
+    void clear() { entries.clear(); }
+
+private:
+    struct Entry {
+        uint32_t generation = 0;
+        float readyAt = 0.0f;
+    };
+
+    int weaponSlots;
+    std::vector<Entry> entries; // [enemy slot * weaponSlots + weapon]
+};
@@ -0,0 +1,90 @@
+#include "HudLayer.h"
+#include "Logger.h"
+
+HudLayer::~HudLayer() {
+    clear();
+}
+
+void HudLayer::init(SDL_Renderer* sdlRenderer) {
+    renderer = sdlRenderer;
+    cached = SDL_RenderTargetSupported(renderer) == SDL_TRUE;
+    if (!cached) {
+        LOG_WARN(LogCategory::ASSETS, "Render targets not supported - HUD is redrawn every frame");
+    }
+}
+
+void HudLayer::clear() {
+    for (auto& widget : widgets) {
+        if (widget.texture) {
+            SDL_DestroyTexture(widget.texture);
+        }
+        widget = Widget();
+    }
+}
+
+void HudLayer::invalidateAll() {
+    for (auto& widget : widgets) {
+        widget.valid = false;
+    }
+}
+
+bool HudLayer::beginRedraw(HudWidget id, const SDL_Rect& bounds, std::initializer_list<int> values,
+                           int& originX, int& originY) {
+    Widget& widget = widgets[static_cast<int>(id)];
+    widget.bounds = bounds;
+    if (!cached) {
+        originX = bounds.x;
+        originY = bounds.y;
+        return true;
+    }
+
+    bool changed = !widget.valid || (int)values.size() != widget.valueCount;
+    int i = 0;
+    for (int value : values) {
+        if (i >= MAX_BOUND_VALUES) break;
+        if (widget.values[i] != value) changed = true;
+        widget.values[i++] = value;
+    }
+    widget.valueCount = (int)values.size();
+    if (!changed) return false;
+
+    int width = 0;
+    int height = 0;
+    if (widget.texture) {
+        SDL_QueryTexture(widget.texture, nullptr, nullptr, &width, &height);
+    }
+    if (!widget.texture || width != bounds.w || height != bounds.h) {
+        if (widget.texture) {
+            SDL_DestroyTexture(widget.texture);
+        }
+        widget.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, bounds.w, bounds.h);
+        if (!widget.texture) {
+            LOG_ERROR(LogCategory::ASSETS, "Unable to create HUD texture! SDL Error: %s", SDL_GetError());
+            originX = bounds.x;
+            originY = bounds.y;
+            return true; // drawn straight to the screen this frame, retried next frame
+        }
+        SDL_SetTextureBlendMode(widget.texture, SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_SetRenderTarget(renderer, widget.texture);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    widget.valid = true;
+    redraws++;
+    originX = 0;
+    originY = 0;
+    return true;
+}
+
+void HudLayer::endRedraw() {
+    if (cached) {
+        SDL_SetRenderTarget(renderer, nullptr);
+    }
+}
+
+void HudLayer::present(HudWidget id) const {
+    const Widget& widget = widgets[static_cast<int>(id)];
+    if (!cached || !widget.texture || !widget.valid) return;
+    SDL_RenderCopy(renderer, widget.texture, nullptr, &widget.bounds);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <initializer_list>
+
+enum class HudWidget {
+    HEALTH,
+    LEVEL,
+    MATERIALS,
+    WAVE,
+    TIMER,
+    BOSS_BAR,
+    LEADER_BAR,
+    EXPERIENCE_BAR,
+    COUNT
+};
+
+// Retained HUD: each widget is drawn once into its own render target texture
+// and only redrawn when one of the values it shows changes, so a steady HUD
+// costs one texture copy per widget per frame.
+//
+//     int x, y;
+//     if (hud.beginRedraw(HudWidget::LEVEL, bounds, { level }, x, y)) {
+//         ...draw relative to (x, y)...
+//         hud.endRedraw();
+//     }
+//     hud.present(HudWidget::LEVEL);
+//
+// Without render target support every widget is simply drawn to the screen
+// each frame, at its screen position.
+class HudLayer {
+public:
+    static const int MAX_BOUND_VALUES = 4;
+
+    HudLayer() = default;
+    ~HudLayer();
+
+    void init(SDL_Renderer* renderer);
+    void clear();
+    // Forces every widget to redraw; call when the renderer reports its targets were reset
+    void invalidateAll();
+
+    // True if the widget has to be drawn now, with the origin to draw it at:
+    // (0, 0) inside its cleared texture, which is the render target until
+    // endRedraw(). False if the cached texture already shows these values.
+    bool beginRedraw(HudWidget widget, const SDL_Rect& bounds, std::initializer_list<int> values,
+                     int& originX, int& originY);
+    void endRedraw();
+    void present(HudWidget widget) const;
+
+    int getRedrawCount() const { return redraws; } // since init, for the log summary
+
+private:
+    HudLayer(const HudLayer&) = delete;
+    HudLayer& operator=(const HudLayer&) = delete;
+
+    struct Widget {
+        SDL_Texture* texture = nullptr;
+        SDL_Rect bounds = { 0, 0, 0, 0 };
+        int values[MAX_BOUND_VALUES] = {};
+        int valueCount = 0;
+        bool valid = false;
+    };
+
+    SDL_Renderer* renderer = nullptr;
+    bool cached = false; // renderer supports render targets
+    Widget widgets[static_cast<int>(HudWidget::COUNT)];
+    int redraws = 0;
+};
@@ -0,0 +1,293 @@
+#include "InputReplay.h"
+#include "Logger.h"
+#include <cstring>
+
+namespace {
+    const char MAGIC[4] = { 'B', 'R', 'P', 'L' };
+    const uint16_t VERSION = 1;
+    const int HEADER_SIZE = 21;
+
+    const uint8_t RECORD_INPUT = 1;
+    const uint8_t RECORD_CHECKSUM = 2;
+    const int INPUT_RECORD_SIZE = 9;
+    const int CHECKSUM_RECORD_SIZE = 9;
+
+    const uint8_t FLAG_AUTO_CLOSE_SHOP = 1 << 0;
+
+    struct KeyBinding {
+        SDL_Scancode scancode;
+        InputButton button;
+    };
+
+    // The first binding of a button is the key toKeyState() presses for it
+    const KeyBinding KEY_BINDINGS[] = {
+        { SDL_SCANCODE_W, InputButton::UP },
+        { SDL_SCANCODE_S, InputButton::DOWN },
+        { SDL_SCANCODE_A, InputButton::LEFT },
+        { SDL_SCANCODE_D, InputButton::RIGHT },
+        { SDL_SCANCODE_UP, InputButton::UP },
+        { SDL_SCANCODE_DOWN, InputButton::DOWN },
+        { SDL_SCANCODE_LEFT, InputButton::LEFT },
+        { SDL_SCANCODE_RIGHT, InputButton::RIGHT },
+        { SDL_SCANCODE_1, InputButton::BUY_1 },
+        { SDL_SCANCODE_2, InputButton::BUY_2 },
+        { SDL_SCANCODE_3, InputButton::BUY_3 },
+        { SDL_SCANCODE_4, InputButton::BUY_4 },
+        { SDL_SCANCODE_L, InputButton::LOCK },
+        { SDL_SCANCODE_R, InputButton::REROLL },
+        { SDL_SCANCODE_ESCAPE, InputButton::CLOSE_SHOP }
+    };
+
+    void putU8(std::vector<uint8_t>& out, uint8_t value) {
+        out.push_back(value);
+    }
+
+    void putU16(std::vector<uint8_t>& out, uint16_t value) {
+        out.push_back((uint8_t)value);
+        out.push_back((uint8_t)(value >> 8));
+    }
+
+    void putU32(std::vector<uint8_t>& out, uint32_t value) {
+        putU16(out, (uint16_t)value);
+        putU16(out, (uint16_t)(value >> 16));
+    }
+
+    void putU64(std::vector<uint8_t>& out, uint64_t value) {
+        putU32(out, (uint32_t)value);
+        putU32(out, (uint32_t)(value >> 32));
+    }
+
+    uint16_t getU16(const uint8_t* in) {
+        return (uint16_t)(in[0] | (in[1] << 8));
+    }
+
+    uint32_t getU32(const uint8_t* in) {
+        return (uint32_t)getU16(in) | ((uint32_t)getU16(in + 2) << 16);
+    }
+
+    uint64_t getU64(const uint8_t* in) {
+        return (uint64_t)getU32(in) | ((uint64_t)getU32(in + 4) << 32);
+    }
+
+    int16_t clampCoordinate(int value) {
+        if (value < INT16_MIN) return INT16_MIN;
+        if (value > INT16_MAX) return INT16_MAX;
+        return (int16_t)value;
+    }
+}
+
+void InputFrame::setHeld(InputButton button, bool held) {
+    if (held) {
+        buttons |= static_cast<uint16_t>(button);
+    } else {
+        buttons &= ~static_cast<uint16_t>(button);
+    }
+}
+
+InputFrame InputFrame::sample() {
+    InputFrame frame;
+    const Uint8* keyState = SDL_GetKeyboardState(nullptr);
+    for (const auto& binding : KEY_BINDINGS) {
+        if (keyState[binding.scancode]) {
+            frame.setHeld(binding.button, true);
+        }
+    }
+
+    int x = 0;
+    int y = 0;
+    Uint32 mouseState = SDL_GetMouseState(&x, &y);
+    frame.setHeld(InputButton::MOUSE_LEFT, (mouseState & SDL_BUTTON(SDL_BUTTON_LEFT)) != 0);
+    frame.mouseX = clampCoordinate(x);
+    frame.mouseY = clampCoordinate(y);
+    return frame;
+}
+
+void InputFrame::toKeyState(Uint8* keyState) const {
+    std::memset(keyState, 0, SDL_NUM_SCANCODES);
+    uint16_t pressed = 0;
+    for (const auto& binding : KEY_BINDINGS) {
+        uint16_t bit = static_cast<uint16_t>(binding.button);
+        if ((buttons & bit) && !(pressed & bit)) {
+            keyState[binding.scancode] = 1;
+            pressed |= bit;
+        }
+    }
+}
+
+ReplayWriter::~ReplayWriter() {
+    close();
+}
+
+bool ReplayWriter::open(const std::string& path, const ReplayHeader& header) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR(LogCategory::GAME, "Unable to create replay file %s", path.c_str());
+        return false;
+    }
+
+    uint32_t spawnBits;
+    std::memcpy(&spawnBits, &header.spawnMultiplier, sizeof(spawnBits));
+
+    record.clear();
+    record.insert(record.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    putU16(record, VERSION);
+    putU16(record, (uint16_t)header.tickRate);
+    putU64(record, header.seed);
+    putU32(record, spawnBits);
+    putU8(record, header.autoCloseShop ? FLAG_AUTO_CLOSE_SHOP : 0);
+    put(record);
+
+    pendingRepeat = 0;
+    ticks = 0;
+    return true;
+}
+
+void ReplayWriter::write(const InputFrame& frame) {
+    if (!file) return;
+
+    ticks++;
+    if (pendingRepeat > 0 && frame == pending && pendingRepeat < UINT16_MAX) {
+        pendingRepeat++;
+        return;
+    }
+    flushRun();
+    pending = frame;
+    pendingRepeat = 1;
+}
+
+void ReplayWriter::writeChecksum(uint32_t tick, uint32_t checksum) {
+    if (!file) return;
+
+    // Runs and checkpoints are matched up by tick, so the open run can stay open
+    record.clear();
+    putU8(record, RECORD_CHECKSUM);
+    putU32(record, tick);
+    putU32(record, checksum);
+    put(record);
+}
+
+void ReplayWriter::close() {
+    if (!file) return;
+
+    flushRun();
+    std::fclose(file);
+    file = nullptr;
+}
+
+void ReplayWriter::flushRun() {
+    if (pendingRepeat == 0) return;
+
+    record.clear();
+    putU8(record, RECORD_INPUT);
+    putU16(record, (uint16_t)pendingRepeat);
+    putU16(record, pending.buttons);
+    putU16(record, (uint16_t)pending.mouseX);
+    putU16(record, (uint16_t)pending.mouseY);
+    put(record);
+    pendingRepeat = 0;
+}
+
+void ReplayWriter::put(const std::vector<uint8_t>& data) {
+    std::fwrite(data.data(), 1, data.size(), file);
+    bytes += (long)data.size();
+}
+
+bool ReplayReader::open(const std::string& path, ReplayHeader& header) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        LOG_ERROR(LogCategory::GAME, "Unable to open replay file %s", path.c_str());
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + read);
+    }
+    std::fclose(file);
+
+    if (data.size() < (size_t)HEADER_SIZE || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        LOG_ERROR(LogCategory::GAME, "%s is not a replay file", path.c_str());
+        return false;
+    }
+    const uint8_t* in = data.data();
+    uint16_t version = getU16(in + 4);
+    if (version != VERSION) {
+        LOG_ERROR(LogCategory::GAME, "Replay %s has version %d, expected %d", path.c_str(), version, VERSION);
+        return false;
+    }
+    header.tickRate = getU16(in + 6);
+    header.seed = getU64(in + 8);
+    uint32_t spawnBits = getU32(in + 16);
+    std::memcpy(&header.spawnMultiplier, &spawnBits, sizeof(spawnBits));
+    header.autoCloseShop = (in[20] & FLAG_AUTO_CLOSE_SHOP) != 0;
+
+    runs.clear();
+    checkpoints.clear();
+    totalTicks = 0;
+    size_t offset = HEADER_SIZE;
+    while (offset < data.size()) {
+        uint8_t tag = data[offset];
+        size_t size = tag == RECORD_INPUT ? INPUT_RECORD_SIZE : tag == RECORD_CHECKSUM ? CHECKSUM_RECORD_SIZE : 0;
+        if (size == 0 || offset + size > data.size()) {
+            // A recording cut short (crash, killed process) still plays up to here
+            LOG_WARN(LogCategory::GAME, "Replay %s is damaged at byte %zu - playing the first %u ticks",
+                     path.c_str(), offset, totalTicks);
+            break;
+        }
+
+        const uint8_t* recordData = in + offset + 1;
+        if (tag == RECORD_INPUT) {
+            Run run;
+            run.repeat = getU16(recordData);
+            run.frame.buttons = getU16(recordData + 2);
+            run.frame.mouseX = (int16_t)getU16(recordData + 4);
+            run.frame.mouseY = (int16_t)getU16(recordData + 6);
+            totalTicks += run.repeat;
+            runs.push_back(run);
+        } else {
+            checkpoints.push_back({ getU32(recordData), getU32(recordData + 4) });
+        }
+        offset += size;
+    }
+
+    runIndex = 0;
+    runPlayed = 0;
+    checkpointIndex = 0;
+    verified = 0;
+    diverged = false;
+    divergedTick = 0;
+    loaded = true;
+    return true;
+}
+
+bool ReplayReader::next(InputFrame& frame) {
+    while (runIndex < runs.size() && runPlayed >= runs[runIndex].repeat) {
+        runIndex++;
+        runPlayed = 0;
+    }
+    if (runIndex >= runs.size()) return false;
+
+    frame = runs[runIndex].frame;
+    runPlayed++;
+    return true;
+}
+
+bool ReplayReader::verify(uint32_t tick, uint32_t checksum) {
+    while (checkpointIndex < checkpoints.size() && checkpoints[checkpointIndex].tick < tick) {
+        checkpointIndex++;
+    }
+    if (checkpointIndex >= checkpoints.size() || checkpoints[checkpointIndex].tick != tick) {
+        return true;
+    }
+
+    bool matches = checkpoints[checkpointIndex++].checksum == checksum;
+    if (matches) {
+        verified++;
+    } else if (!diverged) {
+        diverged = true;
+        divergedTick = tick;
+    }
+    return matches;
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Everything the player can hold down, one bit each in InputFrame::buttons.
+// Arrow keys share the WASD bits.
+enum class InputButton : uint16_t {
+    UP          = 1 << 0,
+    DOWN        = 1 << 1,
+    LEFT        = 1 << 2,
+    RIGHT       = 1 << 3,
+    BUY_1       = 1 << 4,
+    BUY_2       = 1 << 5,
+    BUY_3       = 1 << 6,
+    BUY_4       = 1 << 7,
+    LOCK        = 1 << 8,
+    REROLL      = 1 << 9,
+    CLOSE_SHOP  = 1 << 10,
+    MOUSE_LEFT  = 1 << 11
+};
+
+// The input state the simulation sees for one tick: held buttons plus the
+// mouse position (aim target, or the cursor over the shop).
+struct InputFrame {
+    uint16_t buttons = 0;
+    int16_t mouseX = 0;
+    int16_t mouseY = 0;
+
+    bool isHeld(InputButton button) const { return (buttons & static_cast<uint16_t>(button)) != 0; }
+    void setHeld(InputButton button, bool held);
+
+    // Current SDL keyboard and mouse state
+    static InputFrame sample();
+    // Rebuilds an SDL_GetKeyboardState-style array (SDL_NUM_SCANCODES entries)
+    // so the player and shop key handlers run unchanged
+    void toKeyState(Uint8* keyState) const;
+
+    bool operator==(const InputFrame& other) const {
+        return buttons == other.buttons && mouseX == other.mouseX && mouseY == other.mouseY;
+    }
+    bool operator!=(const InputFrame& other) const { return !(*this == other); }
+};
+
+// The settings a run depends on besides its input; playback overrides the
+// command line with them.
+struct ReplayHeader {
+    uint64_t seed = 0;
+    int tickRate = 60;
+    float spawnMultiplier = 1.0f;
+    bool autoCloseShop = false;
+};
+
+// Streams a run to a replay file: the header, then one input frame per tick,
+// with identical consecutive frames stored once with a repeat count, and a
+// state checksum every so often so playback can tell where it diverged.
+//
+// Layout (little endian):
+//     "BRPL", u16 version, u16 tickRate, u64 seed, f32 spawnMultiplier, u8 flags
+//     then records, each starting with a u8 tag:
+//     1 = input run:  u16 repeat, u16 buttons, i16 mouseX, i16 mouseY
+//     2 = checksum:   u32 tick, u32 checksum (state after that many ticks)
+class ReplayWriter {
+public:
+    ReplayWriter() = default;
+    ~ReplayWriter();
+
+    bool open(const std::string& path, const ReplayHeader& header);
+    void write(const InputFrame& frame);
+    void writeChecksum(uint32_t tick, uint32_t checksum);
+    void close();
+
+    bool isOpen() const { return file != nullptr; }
+    uint32_t getTickCount() const { return ticks; }
+    long getByteCount() const { return bytes; }
+
+private:
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    void flushRun();
+    void put(const std::vector<uint8_t>& data);
+
+    FILE* file = nullptr;
+    InputFrame pending;
+    uint32_t pendingRepeat = 0;
+    uint32_t ticks = 0;
+    long bytes = 0;
+    std::vector<uint8_t> record; // reused for every record
+};
+
+// Loads a whole replay file and hands its frames back one tick at a time.
+class ReplayReader {
+public:
+    // Logs the reason and returns false if the file is missing, truncated or not a replay
+    bool open(const std::string& path, ReplayHeader& header);
+    bool isOpen() const { return loaded; }
+
+    // False once every recorded tick has been played
+    bool next(InputFrame& frame);
+    // Compares against the checksum recorded after this tick, if there is one.
+    // False on a mismatch; the first one is remembered.
+    bool verify(uint32_t tick, uint32_t checksum);
+
+    uint32_t getTickCount() const { return totalTicks; }
+    int getVerifiedCount() const { return verified; }
+    bool hasDiverged() const { return diverged; }
+    uint32_t getDivergedTick() const { return divergedTick; }
+
+private:
+    struct Run {
+        InputFrame frame;
+        uint32_t repeat;
+    };
+    struct Checkpoint {
+        uint32_t tick;
+        uint32_t checksum;
+    };
+
+    bool loaded = false;
+    std::vector<Run> runs;
+    std::vector<Checkpoint> checkpoints; // in tick order
+    uint32_t totalTicks = 0;
+
+    size_t runIndex = 0;
+    uint32_t runPlayed = 0;
+    size_t checkpointIndex = 0;
+    int verified = 0;
+    bool diverged = false;
+    uint32_t divergedTick = 0;
+};
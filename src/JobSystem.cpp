@@ -0,0 +1,125 @@
+#include "JobSystem.h"
+
+JobSystem& JobSystem::instance() {
+    static JobSystem jobSystem;
+    return jobSystem;
+}
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+void JobSystem::init(int workerCount) {
+    shutdown();
+    if (workerCount < 0) {
+        int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = false;
+    }
+    queues.clear();
+    for (int i = 0; i < workerCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+void JobSystem::shutdown() {
+    if (workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    queues.clear();
+}
+
+void JobSystem::dispatch(Job job, int count, int grainSize, int chunks) {
+    std::atomic<int> pending{ chunks };
+    job.pending = &pending;
+
+    // Deal chunks round-robin; stealing evens out whatever imbalance is left
+    int workerCount = static_cast<int>(queues.size());
+    for (int chunk = 0; chunk < chunks; ++chunk) {
+        job.chunk = chunk;
+        job.begin = chunk * grainSize;
+        job.end = job.begin + grainSize < count ? job.begin + grainSize : count;
+        WorkerQueue& queue = *queues[chunk % workerCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    {
+        // Published under the wake mutex so a worker about to sleep cannot miss it
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        queuedJobs.fetch_add(chunks, std::memory_order_release);
+    }
+    wakeCondition.notify_all();
+
+    // The caller works too instead of blocking
+    Job stolen;
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (tryTakeJob(-1, stolen)) {
+            execute(stolen);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(int index) {
+    Job job;
+    while (true) {
+        if (tryTakeJob(index, job)) {
+            execute(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this] {
+            return stopping || queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping) return;
+    }
+}
+
+bool JobSystem::tryTakeJob(int index, Job& job) {
+    if (queuedJobs.load(std::memory_order_acquire) <= 0) return false;
+
+    int workerCount = static_cast<int>(queues.size());
+    if (index >= 0) {
+        WorkerQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    int start = index >= 0 ? index + 1 : 0;
+    for (int i = 0; i < workerCount; ++i) {
+        WorkerQueue& victim = *queues[(start + i) % workerCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::execute(const Job& job) {
+    job.run(job.context, job.chunk, job.begin, job.end);
+    job.pending->fetch_sub(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Work-stealing thread pool for data-parallel loops over entity ranges.
+// parallelFor() cuts [0, count) into fixed-size chunks and deals them out to
+// per-worker deques; a worker pops from the back of its own deque and steals
+// from the front of the others', and the calling thread helps until every
+// chunk is done. Chunk boundaries depend only on count and grain size, never
+// on thread count, so per-chunk output merged in chunk order is deterministic.
+// Jobs must not call parallelFor() themselves, log, or touch the RNG streams.
+class JobSystem {
+public:
+    static JobSystem& instance();
+
+    // Starts workerCount background threads; negative = one per hardware
+    // thread besides the caller, 0 = run every loop inline on the caller
+    void init(int workerCount);
+    // Joins the workers; parallelFor() keeps working, inline
+    void shutdown();
+
+    int getWorkerCount() const { return static_cast<int>(workers.size()); }
+
+    static int chunkCount(int count, int grainSize) {
+        return count > 0 ? (count + grainSize - 1) / grainSize : 0;
+    }
+
+    // Calls body(chunk, begin, end) for every chunk of [0, count) and returns
+    // once all of them have finished. Runs inline when there are no workers or
+    // only one chunk.
+    template <typename Body>
+    void parallelFor(int count, int grainSize, Body&& body) {
+        int chunks = chunkCount(count, grainSize);
+        if (chunks == 0) return;
+        if (workers.empty() || chunks == 1) {
+            for (int chunk = 0; chunk < chunks; ++chunk) {
+                int begin = chunk * grainSize;
+                body(chunk, begin, begin + grainSize < count ? begin + grainSize : count);
+            }
+            return;
+        }
+
+        using BodyType = typename std::remove_reference<Body>::type;
+        Job job;
+        job.run = [](void* context, int chunk, int begin, int end) {
+            (*static_cast<BodyType*>(context))(chunk, begin, end);
+        };
+        job.context = const_cast<void*>(static_cast<const void*>(&body));
+        dispatch(job, count, grainSize, chunks);
+    }
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    struct Job {
+        void (*run)(void* context, int chunk, int begin, int end) = nullptr;
+        void* context = nullptr;
+        int chunk = 0;
+        int begin = 0;
+        int end = 0;
+        std::atomic<int>* pending = nullptr; // chunks of this parallelFor still running
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void dispatch(Job job, int count, int grainSize, int chunks);
+    void workerLoop(int index);
+    // Own queue first (back), then steal from the others (front). index < 0 = the caller
+    bool tryTakeJob(int index, Job& job);
+    static void execute(const Job& job);
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkerQueue>> queues; // one per worker
+
+    std::atomic<int> queuedJobs{ 0 };
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    bool stopping = false; // guarded by wakeMutex
+};
@@ -0,0 +1,155 @@
+#include "Logger.h"
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+    const char* levelName(LogLevel level) {
+        switch (level) {
+            case LogLevel::DEBUG: return "DEBUG";
+            case LogLevel::INFO: return "INFO";
+            case LogLevel::WARN: return "WARN";
+            default: return "ERROR";
+        }
+    }
+
+    const char* categoryName(LogCategory category) {
+        switch (category) {
+            case LogCategory::GAME: return "game";
+            case LogCategory::SPAWN: return "spawn";
+            case LogCategory::COMBAT: return "combat";
+            case LogCategory::PLAYER: return "player";
+            case LogCategory::SHOP: return "shop";
+            case LogCategory::ASSETS: return "assets";
+            default: return "?";
+        }
+    }
+
+    // Idle wait for the drain thread when the ring is empty
+    const std::chrono::milliseconds DRAIN_IDLE_SLEEP(5);
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : startTime(std::chrono::steady_clock::now()) {
+    for (auto& window : rateWindows) {
+        window.limit = 50;
+    }
+    // Per-hit messages; a bullet storm must not flood the ring
+    rateWindows[static_cast<int>(LogCategory::COMBAT)].limit = 10;
+
+    running = true;
+    drainThread = std::thread(&Logger::drainLoop, this);
+}
+
+Logger::~Logger() {
+    shutdown();
+}
+
+void Logger::shutdown() {
+    if (!running.exchange(false)) return;
+    if (drainThread.joinable()) {
+        drainThread.join();
+    }
+}
+
+void Logger::setRateLimit(LogCategory category, int messagesPerSecond) {
+    rateWindows[static_cast<int>(category)].limit = messagesPerSecond;
+}
+
+uint32_t Logger::nowMs() const {
+    auto elapsed = std::chrono::steady_clock::now() - startTime;
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+void Logger::write(LogLevel level, LogCategory category, const char* format, ...) {
+    Record record;
+    record.timeMs = nowMs();
+    record.level = level;
+    record.category = category;
+
+    // Errors always go through; everything else is counted against its category
+    RateWindow& window = rateWindows[static_cast<int>(category)];
+    if (level != LogLevel::ERR && window.limit > 0) {
+        int64_t second = record.timeMs / 1000;
+        if (second != window.windowStartMs) {
+            if (window.suppressed > 0) {
+                Record note = record;
+                note.level = LogLevel::WARN;
+                std::snprintf(note.text, sizeof(note.text), "%d messages suppressed by rate limit", window.suppressed);
+                push(note);
+            }
+            window.windowStartMs = second;
+            window.count = 0;
+            window.suppressed = 0;
+        }
+        if (window.count >= window.limit) {
+            window.suppressed++;
+            return;
+        }
+        window.count++;
+    }
+
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(record.text, sizeof(record.text), format, args);
+    va_end(args);
+
+    push(record);
+}
+
+void Logger::push(const Record& record) {
+    if (!running.load(std::memory_order_relaxed)) {
+        // Before init or after shutdown there is no drain thread
+        print(record);
+        return;
+    }
+
+    uint32_t h = head.load(std::memory_order_relaxed);
+    uint32_t t = tail.load(std::memory_order_acquire);
+    if (h - t >= static_cast<uint32_t>(CAPACITY)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    records[h & (CAPACITY - 1)] = record;
+    head.store(h + 1, std::memory_order_release);
+}
+
+bool Logger::drainOnce() {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t h = head.load(std::memory_order_acquire);
+    if (t == h) return false;
+
+    for (; t != h; ++t) {
+        print(records[t & (CAPACITY - 1)]);
+        tail.store(t + 1, std::memory_order_release);
+    }
+
+    uint32_t droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != droppedReported) {
+        std::cout << "[log] " << (droppedNow - droppedReported) << " messages dropped (ring full)\n";
+        droppedReported = droppedNow;
+    }
+    std::cout.flush();
+    return true;
+}
+
+void Logger::drainLoop() {
+    while (running.load(std::memory_order_acquire)) {
+        if (!drainOnce()) {
+            std::this_thread::sleep_for(DRAIN_IDLE_SLEEP);
+        }
+    }
+    // Whatever was queued before shutdown
+    drainOnce();
+}
+
+void Logger::print(const Record& record) {
+    char prefix[48];
+    std::snprintf(prefix, sizeof(prefix), "[%u.%03u %s %s] ",
+                  record.timeMs / 1000, record.timeMs % 1000, levelName(record.level), categoryName(record.category));
+    std::cout << prefix << record.text << '\n';
+}
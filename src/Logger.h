@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+enum class LogLevel {
+    DEBUG,
+    INFO,
+    WARN,
+    ERR
+};
+
+enum class LogCategory {
+    GAME,     // init, waves, seeds
+    SPAWN,    // enemies and bosses
+    COMBAT,   // hits, dodges, node deaths - the chatty one
+    PLAYER,   // level ups, weapons
+    SHOP,
+    ASSETS,   // textures, fonts, primitives
+    COUNT
+};
+
+// Levels below this are compiled out entirely (arguments are not evaluated).
+// Defaults to DEBUG in debug builds and INFO with NDEBUG; override with
+// -DBROTATO_LOG_MIN_LEVEL=<0..3>.
+#ifndef BROTATO_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define BROTATO_LOG_MIN_LEVEL 1
+#else
+#define BROTATO_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+#define LOG_AT(level, category, ...) Logger::instance().write(level, category, __VA_ARGS__)
+
+#if BROTATO_LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG(category, ...) LOG_AT(LogLevel::DEBUG, category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...) ((void)0)
+#endif
+#if BROTATO_LOG_MIN_LEVEL <= 1
+#define LOG_INFO(category, ...) LOG_AT(LogLevel::INFO, category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...) ((void)0)
+#endif
+#if BROTATO_LOG_MIN_LEVEL <= 2
+#define LOG_WARN(category, ...) LOG_AT(LogLevel::WARN, category, __VA_ARGS__)
+#else
+#define LOG_WARN(category, ...) ((void)0)
+#endif
+#define LOG_ERROR(category, ...) LOG_AT(LogLevel::ERR, category, __VA_ARGS__)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOG_PRINTF_FORMAT(fmtIndex, argsIndex) __attribute__((format(printf, fmtIndex, argsIndex)))
+#else
+#define LOG_PRINTF_FORMAT(fmtIndex, argsIndex)
+#endif
+
+// Asynchronous logger. write() formats into a fixed-size record in a lock-free
+// single-producer/single-consumer ring and returns; a background thread drains
+// the ring to stdout. A full ring drops the message (counted and reported)
+// rather than blocking the frame. Each category is rate limited per second.
+// Single producer: only log from the main thread.
+class Logger {
+public:
+    static const int CAPACITY = 1024;       // records, power of two
+    static const int MESSAGE_SIZE = 232;    // bytes of text per record, truncated beyond
+
+    static Logger& instance();
+
+    void write(LogLevel level, LogCategory category, const char* format, ...) LOG_PRINTF_FORMAT(4, 5);
+
+    // Messages per second per category before the rest of that second is dropped; 0 = unlimited
+    void setRateLimit(LogCategory category, int messagesPerSecond);
+
+    // Drains what is queued and stops the thread; later writes print synchronously
+    void shutdown();
+
+private:
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    struct Record {
+        uint32_t timeMs;
+        LogLevel level;
+        LogCategory category;
+        char text[MESSAGE_SIZE];
+    };
+
+    struct RateWindow {
+        int limit = 0;
+        int64_t windowStartMs = -1;
+        int count = 0;
+        int suppressed = 0;
+    };
+
+    void push(const Record& record);
+    void drainLoop();
+    bool drainOnce();
+    static void print(const Record& record);
+    uint32_t nowMs() const;
+
+    Record records[CAPACITY];
+    alignas(64) std::atomic<uint32_t> head{ 0 }; // next slot the producer writes
+    alignas(64) std::atomic<uint32_t> tail{ 0 }; // next slot the consumer reads
+    std::atomic<uint32_t> dropped{ 0 };
+    uint32_t droppedReported = 0;               // consumer side
+
+    RateWindow rateWindows[static_cast<int>(LogCategory::COUNT)]; // producer side
+
+    std::chrono::steady_clock::time_point startTime;
+    std::atomic<bool> running{ false };
+    std::thread drainThread;
+};
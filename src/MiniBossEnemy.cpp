@@ -1,11 +1,14 @@
 #include "MiniBossEnemy.h"
-#include "Bullet.h"
-#include <SDL2/SDL_image.h>
+#include "Profiler.h"
+#include "BulletPool.h"
+#include "TextureCache.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
 #include <cmath>
 #include <iostream>
 
-MiniBossEnemy::MiniBossEnemy(Vector2 pos, SDL_Renderer* renderer, int variantIndex, bool isLeaderPart)
-    : Enemy(pos, renderer), fireCooldown(2.0f), timeSinceLastShot(0.0f), bulletSpeed(500.0f), bulletDamage(8),
+MiniBossEnemy::MiniBossEnemy(Vector2 pos, int variantIndex, bool isLeaderPart)
+    : Enemy(pos), fireCooldown(2.0f), timeSinceLastShot(0.0f), bulletSpeed(500.0f), bulletDamage(8),
       variant(variantIndex), bossTexture(nullptr), bossRushTexture(nullptr), facingRight(false), leader(isLeaderPart), maxHealth(100) {
     // Stats
     if (leader) {
@@ -34,43 +37,22 @@ MiniBossEnemy::MiniBossEnemy(Vector2 pos, SDL_Renderer* renderer, int variantInd
         default: break;
     }
 
-    loadSprites(renderer);
+    loadSprites();
 }
 
 MiniBossEnemy::~MiniBossEnemy() {
-    if (bossRushTexture) {
-        SDL_DestroyTexture(bossRushTexture);
-        bossRushTexture = nullptr;
-    }
+    TextureCache& cache = TextureCache::instance();
+    cache.release(bossTexture);
+    cache.release(bossRushTexture);
 }
 
-void MiniBossEnemy::loadSprites(SDL_Renderer* renderer) {
-    SDL_Surface* surface = IMG_Load("assets/enemies/bossT.png");
-    if (!surface) {
-        std::cout << "Failed to load bossT.png: " << IMG_GetError() << std::endl;
-        bossTexture = nullptr;
-    } else {
-        bossTexture = SDL_CreateTextureFromSurface(renderer, surface);
-        SDL_FreeSurface(surface);
-        if (!bossTexture) {
-            std::cout << "Failed to create miniboss texture: " << SDL_GetError() << std::endl;
-        }
-    }
-
-    surface = IMG_Load("assets/enemies/bossT_rush.png");
-    if (!surface) {
-        std::cout << "Failed to load bossT_rush.png: " << IMG_GetError() << std::endl;
-        bossRushTexture = nullptr;
-    } else {
-        bossRushTexture = SDL_CreateTextureFromSurface(renderer, surface);
-        SDL_FreeSurface(surface);
-        if (!bossRushTexture) {
-            std::cout << "Failed to create miniboss rush texture: " << SDL_GetError() << std::endl;
-        }
-    }
+void MiniBossEnemy::loadSprites() {
+    TextureCache& cache = TextureCache::instance();
+    bossTexture = cache.acquire("assets/enemies/bossT.png");
+    bossRushTexture = cache.acquire("assets/enemies/bossT_rush.png");
 }
 
-void MiniBossEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
+void MiniBossEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) {
     timeSinceLastShot += deltaTime;
     if (timeSinceLastShot < fireCooldown) return;
     timeSinceLastShot = 0.0f;
@@ -89,7 +71,7 @@ void MiniBossEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vec
         default: break;
     }
 
-    bullets.push_back(std::make_unique<Bullet>(
+    bullets.spawn(
         position,
         direction,
         /*damage*/ bulletDamage,
@@ -97,10 +79,11 @@ void MiniBossEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vec
         /*speed*/ bulletSpeed,
         btype,
         /*enemyOwned*/ true
-    ));
+    );
 }
 
-void MiniBossEnemy::update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
+void MiniBossEnemy::update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) {
+    PROFILE_SCOPE("MiniBossEnemy::update");
     // Movement towards player
     Vector2 direction = (playerPos - position).normalized();
     velocity = direction * speed;
@@ -127,8 +110,10 @@ void MiniBossEnemy::update(float deltaTime, Vector2 playerPos, std::vector<std::
     }
 }
 
-void MiniBossEnemy::render(SDL_Renderer* renderer) {
+void MiniBossEnemy::render(SDL_Renderer* renderer, float alpha) {
+    PROFILE_SCOPE("MiniBossEnemy::render");
     if (!alive) return;
+    Vector2 drawPos = Vector2::lerp(previousPosition, position, alpha);
 
     SDL_Texture* currentTexture = nullptr;
     // Simple state without sprint phases for now
@@ -138,56 +123,47 @@ void MiniBossEnemy::render(SDL_Renderer* renderer) {
 
     if (currentTexture) {
         SDL_Rect dst{
-            (int)(position.x - spriteWidth/2),
-            (int)(position.y - spriteHeight/2),
+            (int)(drawPos.x - spriteWidth/2),
+            (int)(drawPos.y - spriteHeight/2),
             spriteWidth,
             spriteHeight
         };
         SDL_RendererFlip flip = facingRight ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-        SDL_RenderCopyEx(renderer, currentTexture, nullptr, &dst, 0.0, nullptr, flip);
+        SpriteBatch::instance().copyEx(currentTexture, nullptr, dst, 0.0, flip);
     } else {
         // Fallback circle
-        SDL_SetRenderDrawColor(renderer, 120, 20, 20, 255);
-        int cx = (int)position.x;
-        int cy = (int)position.y;
+        int cx = (int)drawPos.x;
+        int cy = (int)drawPos.y;
         int r = (int)radius;
-        for (int x = -r; x <= r; ++x) {
-            for (int y = -r; y <= r; ++y) {
-                if (x*x + y*y <= r*r) {
-                    SDL_RenderDrawPoint(renderer, cx + x, cy + y);
-                }
-            }
-        }
+        PrimitiveCache::instance().drawCircle(cx, cy, r, { 120, 20, 20, 255 });
     }
 
     // Small HP bar above head
     int barWidth = leader ? 80 : 60;
     int barHeight = leader ? 8 : 6;
-    int barX = (int)position.x - barWidth/2;
-    int barY = (int)(position.y - spriteHeight/2) - 12;
+    int barX = (int)drawPos.x - barWidth/2;
+    int barY = (int)(drawPos.y - spriteHeight/2) - 12;
     if (barY < 0) barY = 0;
 
+    SpriteBatch& batch = SpriteBatch::instance();
     // Background
-    SDL_SetRenderDrawColor(renderer, 139, 0, 0, 255);
     SDL_Rect bg = {barX, barY, barWidth, barHeight};
-    SDL_RenderFillRect(renderer, &bg);
+    batch.fillRect(bg, {139, 0, 0, 255});
     // Foreground proportional to health
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
     int fgWidth = (health * barWidth) / maxHealth;
     if (fgWidth < 0) fgWidth = 0;
     SDL_Rect fg = {barX, barY, fgWidth, barHeight};
-    SDL_RenderFillRect(renderer, &fg);
+    batch.fillRect(fg, {255, 0, 0, 255});
     // Border
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    SDL_RenderDrawRect(renderer, &bg);
+    batch.drawRect(bg, {255, 255, 255, 255});
 }
 
 int MiniBossEnemy::getMaxHealth() const {
     return maxHealth;
 }
 
-std::unique_ptr<Enemy> CreateMiniBossEnemy(const Vector2& pos, SDL_Renderer* renderer, int variantIndex, bool isLeader) {
-    return std::make_unique<MiniBossEnemy>(pos, renderer, variantIndex, isLeader);
+std::unique_ptr<Enemy> CreateMiniBossEnemy(const Vector2& pos, int variantIndex, bool isLeader) {
+    return std::make_unique<MiniBossEnemy>(pos, variantIndex, isLeader);
 }
 
 
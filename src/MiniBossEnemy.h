@@ -4,22 +4,22 @@
 #include <memory>
 #include <vector>
 
-class Bullet;
+class BulletEmitter;
 
 class MiniBossEnemy : public Enemy {
 public:
-    MiniBossEnemy(Vector2 pos, SDL_Renderer* renderer, int variantIndex, bool isLeaderPart);
+    MiniBossEnemy(Vector2 pos, int variantIndex, bool isLeaderPart);
     ~MiniBossEnemy() override;
 
-    void update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) override;
-    void render(SDL_Renderer* renderer) override;
+    void update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) override;
+    void render(SDL_Renderer* renderer, float alpha) override;
     int getMaxHealth() const override;
     bool isBossUnit() const override { return true; }
     bool isLeader() const override { return leader; }
 
 private:
-    void loadSprites(SDL_Renderer* renderer);
-    void tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets);
+    void loadSprites();
+    void tryFireAtPlayer(float deltaTime, Vector2 playerPos, BulletEmitter& bullets);
 
     // Shooting
     float fireCooldown;
@@ -39,6 +39,6 @@ private:
 };
 
 // Factory
-std::unique_ptr<Enemy> CreateMiniBossEnemy(const Vector2& pos, SDL_Renderer* renderer, int variantIndex, bool isLeader);
+std::unique_ptr<Enemy> CreateMiniBossEnemy(const Vector2& pos, int variantIndex, bool isLeader);
 
 
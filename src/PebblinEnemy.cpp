@@ -1,35 +1,32 @@
 #include "PebblinEnemy.h"
-#include "Bullet.h"
-#include <SDL2/SDL_image.h>
+#include "Profiler.h"
+#include "BulletPool.h"
+#include "TextureCache.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
 #include <cmath>
 #include <iostream>
 
-PebblinEnemy::PebblinEnemy(Vector2 pos, SDL_Renderer* renderer)
-    : Enemy(pos, renderer), fireCooldown(3.5f), timeSinceLastShot(0.0f), pebblinTexture(nullptr) {
+PebblinEnemy::PebblinEnemy(Vector2 pos)
+    : Enemy(pos), fireCooldown(3.5f), timeSinceLastShot(0.0f), pebblinTexture(nullptr) {
     // Heavy, tanky stats - slower but tougher than slimes
     speed = 35.0f;          // Slower than slime (60.0f)
     radius = 30.0f;         // Slightly bigger
     damage = 12;            // More damage
     health = 40;            // More HP than base enemy
-    loadSprites(renderer);
+    loadSprites();
 }
 
-void PebblinEnemy::loadSprites(SDL_Renderer* renderer) {
+PebblinEnemy::~PebblinEnemy() {
+    TextureCache::instance().release(pebblinTexture);
+}
+
+void PebblinEnemy::loadSprites() {
     // Load pebblin sprite
-    SDL_Surface* surface = IMG_Load("assets/enemies/pebblin.png");
-    if (!surface) {
-        std::cout << "Failed to load pebblin.png: " << IMG_GetError() << std::endl;
-        pebblinTexture = nullptr;
-        return;
-    }
-    pebblinTexture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    if (!pebblinTexture) {
-        std::cout << "Failed to create pebblin texture: " << SDL_GetError() << std::endl;
-    }
+    pebblinTexture = TextureCache::instance().acquire("assets/enemies/pebblin.png");
 }
 
-void PebblinEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
+void PebblinEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) {
     timeSinceLastShot += deltaTime;
     if (timeSinceLastShot < fireCooldown) return;
     timeSinceLastShot = 0.0f;
@@ -42,24 +39,25 @@ void PebblinEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vect
     float spreadAngle = 0.3f; // ~17 degrees spread
     
     // Center shot
-    bullets.push_back(std::make_unique<Bullet>(position, centerDir, /*damage*/ 8, /*range*/ 500.0f, /*speed*/ 280.0f, BulletType::PISTOL, /*enemyOwned*/ true));
+    bullets.spawn(position, centerDir, /*damage*/ 8, /*range*/ 500.0f, /*speed*/ 280.0f, BulletType::PISTOL, /*enemyOwned*/ true);
     
     // Left angled shot
     Vector2 leftDir = Vector2(
         centerDir.x * cos(-spreadAngle) - centerDir.y * sin(-spreadAngle),
         centerDir.x * sin(-spreadAngle) + centerDir.y * cos(-spreadAngle)
     );
-    bullets.push_back(std::make_unique<Bullet>(position, leftDir, /*damage*/ 8, /*range*/ 500.0f, /*speed*/ 280.0f, BulletType::PISTOL, /*enemyOwned*/ true));
+    bullets.spawn(position, leftDir, /*damage*/ 8, /*range*/ 500.0f, /*speed*/ 280.0f, BulletType::PISTOL, /*enemyOwned*/ true);
     
     // Right angled shot
     Vector2 rightDir = Vector2(
         centerDir.x * cos(spreadAngle) - centerDir.y * sin(spreadAngle),
         centerDir.x * sin(spreadAngle) + centerDir.y * cos(spreadAngle)
     );
-    bullets.push_back(std::make_unique<Bullet>(position, rightDir, /*damage*/ 8, /*range*/ 500.0f, /*speed*/ 280.0f, BulletType::PISTOL, /*enemyOwned*/ true));
+    bullets.spawn(position, rightDir, /*damage*/ 8, /*range*/ 500.0f, /*speed*/ 280.0f, BulletType::PISTOL, /*enemyOwned*/ true);
 }
 
-void PebblinEnemy::update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
+void PebblinEnemy::update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) {
+    PROFILE_SCOPE("PebblinEnemy::update");
     // Heavy, slow movement toward player
     Vector2 direction = (playerPos - position).normalized();
     velocity = direction * speed;
@@ -83,30 +81,27 @@ void PebblinEnemy::update(float deltaTime, Vector2 playerPos, std::vector<std::u
     }
 }
 
-void PebblinEnemy::render(SDL_Renderer* renderer) {
+void PebblinEnemy::render(SDL_Renderer* renderer, float alpha) {
+    PROFILE_SCOPE("PebblinEnemy::render");
     if (!alive) return;
+    Vector2 drawPos = Vector2::lerp(previousPosition, position, alpha);
     if (pebblinTexture) {
-        int w, h;
-        SDL_QueryTexture(pebblinTexture, nullptr, nullptr, &w, &h);
+        int w = 0, h = 0;
+        TextureCache::instance().getSize(pebblinTexture, w, h);
         float scale = 1.0f; // Slightly bigger than slime
         int sw = (int)(w * scale);
         int sh = (int)(h * scale);
-        SDL_Rect dst{ (int)(position.x - sw/2), (int)(position.y - sh/2), sw, sh };
-        SDL_RenderCopy(renderer, pebblinTexture, nullptr, &dst);
+        SDL_Rect dst{ (int)(drawPos.x - sw/2), (int)(drawPos.y - sh/2), sw, sh };
+        SpriteBatch::instance().copy(pebblinTexture, nullptr, dst);
     } else {
         // Fallback circle in gray/brown for rock
-        SDL_SetRenderDrawColor(renderer, 120, 100, 80, 255);
-        int cx = (int)position.x;
-        int cy = (int)position.y;
+        int cx = (int)drawPos.x;
+        int cy = (int)drawPos.y;
         int r = (int)radius;
-        for (int x = -r; x <= r; ++x) {
-            for (int y = -r; y <= r; ++y) {
-                if (x*x + y*y <= r*r) SDL_RenderDrawPoint(renderer, cx + x, cy + y);
-            }
-        }
+        PrimitiveCache::instance().drawCircle(cx, cy, r, { 120, 100, 80, 255 });
     }
 }
 
-std::unique_ptr<Enemy> CreatePebblinEnemy(const Vector2& pos, SDL_Renderer* renderer) {
-    return std::make_unique<PebblinEnemy>(pos, renderer);
+std::unique_ptr<Enemy> CreatePebblinEnemy(const Vector2& pos) {
+    return std::make_unique<PebblinEnemy>(pos);
 }
\ No newline at end of file
@@ -4,19 +4,19 @@
 #include <memory>
 #include <vector>
 
-class Bullet;
+class BulletEmitter;
 
 class PebblinEnemy : public Enemy {
 public:
-    PebblinEnemy(Vector2 pos, SDL_Renderer* renderer);
-    ~PebblinEnemy() override = default;
+    explicit PebblinEnemy(Vector2 pos);
+    ~PebblinEnemy() override;
     
-    void update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) override;
-    void render(SDL_Renderer* renderer) override;
+    void update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) override;
+    void render(SDL_Renderer* renderer, float alpha) override;
     
 private:
-    void loadSprites(SDL_Renderer* renderer);
-    void tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets);
+    void loadSprites();
+    void tryFireAtPlayer(float deltaTime, Vector2 playerPos, BulletEmitter& bullets);
     
     float fireCooldown;
     float timeSinceLastShot;
@@ -24,4 +24,4 @@ private:
 };
 
 // Factory function
-std::unique_ptr<Enemy> CreatePebblinEnemy(const Vector2& pos, SDL_Renderer* renderer);
\ No newline at end of file
+std::unique_ptr<Enemy> CreatePebblinEnemy(const Vector2& pos);
\ No newline at end of file
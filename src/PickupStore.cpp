@@ -0,0 +1,233 @@
+#include "PickupStore.h"
+#include "Profiler.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
+#include "SpatialGrid.h"
+#include "Random.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    const float MAGNET_SPEED = 600.0f;      // px/s, well above any player move speed
+    const float MAX_MERGED_SCALE = 2.0f;    // a big merged pickup is drawn at most this much larger
+}
+
+PickupStore::PickupStore(PickupKind pickupKind)
+    : kind(pickupKind),
+      posX(CAPACITY), posY(CAPACITY), lifetime(CAPACITY), bobPhase(CAPACITY),
+      magnetized(CAPACITY), alive(CAPACITY), prevX(CAPACITY), prevY(CAPACITY),
+      experienceValue(CAPACITY), materialValue(CAPACITY), weight(CAPACITY) {
+    if (kind == PickupKind::EXPERIENCE_ORB) {
+        baseRadius = 8.0f;
+        maxLifetime = 30.0f;
+        bobSpeed = 3.0f;
+        bobAmplitude = 2.0f;
+    } else {
+        baseRadius = 6.0f;
+        maxLifetime = 60.0f;
+        bobSpeed = 2.0f;
+        bobAmplitude = 3.0f;
+    }
+}
+
+void PickupStore::spawn(Vector2 pos, int expValue, int matValue) {
+    if (count >= CAPACITY) {
+        // Only reachable if coalescing cannot keep up; nothing is lost either way
+        int nearest = -1;
+        float nearestDistSq = 0.0f;
+        for (int i = 0; i < count; ++i) {
+            if (!alive[i]) continue;
+            float dx = posX[i] - pos.x;
+            float dy = posY[i] - pos.y;
+            float distSq = dx * dx + dy * dy;
+            if (nearest < 0 || distSq < nearestDistSq) {
+                nearest = i;
+                nearestDistSq = distSq;
+            }
+        }
+        if (nearest >= 0) {
+            experienceValue[nearest] += expValue;
+            materialValue[nearest] += matValue;
+            return;
+        }
+
+        // Every slot is dead and waiting for compact(): reuse one. Collected and
+        // merged slots carry no value; an expired one hands its value to the new pickup
+        int reused = 0;
+        for (int i = 0; i < count; ++i) {
+            if (experienceValue[i] == 0 && materialValue[i] == 0) {
+                reused = i;
+                break;
+            }
+        }
+        initSlot(reused, pos, expValue + experienceValue[reused], matValue + materialValue[reused]);
+        return;
+    }
+
+    initSlot(count++, pos, expValue, matValue);
+}
+
+void PickupStore::initSlot(int i, Vector2 pos, int expValue, int matValue) {
+    posX[i] = prevX[i] = pos.x;
+    posY[i] = prevY[i] = pos.y;
+    lifetime[i] = 0.0f;
+    // Materials bob out of sync with each other
+    bobPhase[i] = kind == PickupKind::MATERIAL ? rng(RandomStream::VISUAL).range(0.0f, 2.0f * (float)M_PI) : 0.0f;
+    magnetized[i] = 0;
+    alive[i] = 1;
+    experienceValue[i] = expValue;
+    materialValue[i] = matValue;
+    weight[i] = 1;
+}
+
+void PickupStore::updateRange(int begin, int end, float deltaTime, Vector2 target) {
+    PROFILE_SCOPE("PickupStore::updateRange");
+    float step = MAGNET_SPEED * deltaTime;
+    for (int i = begin; i < end; ++i) {
+        lifetime[i] += deltaTime;
+        bobPhase[i] += bobSpeed * deltaTime;
+
+        if (magnetized[i]) {
+            // Already on its way to the player: keep flying, never expire mid-air
+            float dx = target.x - posX[i];
+            float dy = target.y - posY[i];
+            float distSq = dx * dx + dy * dy;
+            if (distSq <= step * step) {
+                posX[i] = target.x;
+                posY[i] = target.y;
+            } else {
+                float scale = step / std::sqrt(distSq);
+                posX[i] += dx * scale;
+                posY[i] += dy * scale;
+            }
+        } else if (lifetime[i] >= maxLifetime) {
+            alive[i] = 0;
+        }
+    }
+}
+
+void PickupStore::insertInto(SpatialGrid& grid) const {
+    for (int i = 0; i < count; ++i) {
+        if (alive[i]) {
+            grid.insert(i, Vector2(posX[i], posY[i]), 0.0f);
+        }
+    }
+}
+
+int PickupStore::coalesce(SpatialGrid& grid, float radius, std::vector<int>& scratch) {
+    PROFILE_SCOPE("PickupStore::coalesce");
+    float radiusSq = radius * radius;
+    int merged = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!alive[i] || magnetized[i]) continue;
+
+        grid.query(Vector2(posX[i], posY[i]), radius, scratch);
+        for (int j : scratch) {
+            // Lower indices already had their turn and would have absorbed i
+            if (j <= i || !alive[j] || magnetized[j]) continue;
+            float dx = posX[j] - posX[i];
+            float dy = posY[j] - posY[i];
+            if (dx * dx + dy * dy > radiusSq) continue;
+
+            experienceValue[i] += experienceValue[j];
+            materialValue[i] += materialValue[j];
+            weight[i] = (uint16_t)std::min(0xFFFF, weight[i] + weight[j]);
+            // The merged pickup lives as long as its freshest part
+            lifetime[i] = std::min(lifetime[i], lifetime[j]);
+            alive[j] = 0;
+            experienceValue[j] = 0;
+            materialValue[j] = 0;
+            merged++;
+        }
+    }
+    return merged;
+}
+
+void PickupStore::collect(int index) {
+    alive[index] = 0;
+    experienceValue[index] = 0;
+    materialValue[index] = 0;
+}
+
+void PickupStore::moveSlot(int from, int to) {
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    lifetime[to] = lifetime[from];
+    bobPhase[to] = bobPhase[from];
+    magnetized[to] = magnetized[from];
+    alive[to] = alive[from];
+    prevX[to] = prevX[from];
+    prevY[to] = prevY[from];
+    experienceValue[to] = experienceValue[from];
+    materialValue[to] = materialValue[from];
+    weight[to] = weight[from];
+}
+
+int PickupStore::compact() {
+    int expiredValue = 0;
+    int i = 0;
+    while (i < count) {
+        if (alive[i]) {
+            ++i;
+        } else {
+            // Collected and merged-away pickups were zeroed; what is left expired
+            expiredValue += materialValue[i];
+            --count;
+            if (i != count) {
+                moveSlot(count, i);
+            }
+        }
+    }
+    return expiredValue;
+}
+
+void PickupStore::storePreviousPositions() {
+    std::memcpy(prevX.data(), posX.data(), count * sizeof(float));
+    std::memcpy(prevY.data(), posY.data(), count * sizeof(float));
+}
+
+float PickupStore::drawRadius(int index) const {
+    return baseRadius * std::min(MAX_MERGED_SCALE, std::sqrt((float)weight[index]));
+}
+
+void PickupStore::render(SDL_Renderer* renderer, float alpha) const {
+    PROFILE_SCOPE("PickupStore::render");
+    PrimitiveCache& primitives = PrimitiveCache::instance();
+    float fadeStart = maxLifetime * 0.8f;
+
+    for (int i = 0; i < count; ++i) {
+        if (!alive[i]) continue;
+
+        float bob = std::sin(bobPhase[i]) * bobAmplitude;
+        int centerX = (int)(prevX[i] + (posX[i] - prevX[i]) * alpha);
+        int centerY = (int)(prevY[i] + (posY[i] - prevY[i]) * alpha + bob);
+        int r = (int)drawRadius(i);
+
+        if (kind == PickupKind::EXPERIENCE_ORB) {
+            // Glowing green orb that fades out over the last 20% of its life
+            float fadeRatio = 1.0f;
+            if (lifetime[i] > fadeStart) {
+                fadeRatio = std::max(0.0f, 1.0f - (lifetime[i] - fadeStart) / (maxLifetime * 0.2f));
+            }
+            Uint8 a = (Uint8)(255 * fadeRatio);
+            primitives.drawRing(centerX, centerY, r, r + 2, { 100, 255, 100, (Uint8)(a * 0.3f) });
+            primitives.drawCircle(centerX, centerY, r, { 150, 255, 150, a });
+            primitives.drawCircle(centerX, centerY, r / 2, { 255, 255, 255, a });
+        } else {
+            // Green blob with a lighter center (materials in Brotato are green)
+            primitives.drawCircle(centerX, centerY, r, { 0, 200, 0, 255 });
+            primitives.drawCircle(centerX, centerY, r / 2, { 100, 255, 100, 255 });
+
+            if (lifetime[i] > fadeStart) {
+                // Visual indicator that the material will disappear soon
+                int ringR = r + 2;
+                for (int angle = 0; angle < 360; angle += 20) {
+                    float rad = angle * (float)M_PI / 180.0f;
+                    SpriteBatch::instance().drawPoint(centerX + (int)(std::cos(rad) * ringR), centerY + (int)(std::sin(rad) * ringR),
+                                                      { 255, 255, 0, 100 });
+                }
+            }
+        }
+    }
+}
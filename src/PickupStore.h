@@ -0,0 +1,84 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+#include "Vector2.h"
+#include "GameEvents.h"
+
+class SpatialGrid;
+
+// Experience orbs or materials (one store per kind), stored as parallel arrays
+// like BulletPool: allocated once for CAPACITY pickups, packed in [0, size())
+// by compact(), indices stable only between two compact() calls.
+//
+// Pickups inside the player's pickup range become magnetized and fly to the
+// player until collected. When a store gets crowded, coalesce() folds pickups
+// lying close together into one that carries their summed value, so the count
+// on screen stays bounded however many enemies die.
+class PickupStore {
+public:
+    static const int CAPACITY = 4096;
+
+    explicit PickupStore(PickupKind kind);
+
+    // Never fails: in a full store the value is added to the nearest live pickup
+    // instead, or takes over a dead slot if none is alive
+    void spawn(Vector2 pos, int experienceValue, int materialValue);
+
+    // Ages, bobs and expires [begin, end) and moves magnetized pickups toward
+    // target; disjoint ranges can run on different threads
+    void updateRange(int begin, int end, float deltaTime, Vector2 target);
+
+    // Merges alive, unmagnetized pickups within radius of each other. The grid
+    // must hold this store's indices (see insertInto). Returns pickups removed.
+    int coalesce(SpatialGrid& grid, float radius, std::vector<int>& scratch);
+
+    void insertInto(SpatialGrid& grid) const;
+    void magnetize(int index) { magnetized[index] = 1; }
+    bool isMagnetized(int index) const { return magnetized[index] != 0; }
+    // Zeroes the value so compact() does not count it as expired
+    void collect(int index);
+
+    // Swap-removes dead pickups; returns the material value of the ones that
+    // expired uncollected (it goes into the material bag)
+    int compact();
+    void clear() { count = 0; }
+
+    void storePreviousPositions();
+    void render(SDL_Renderer* renderer, float alpha) const;
+
+    int size() const { return count; }
+    PickupKind getKind() const { return kind; }
+    Vector2 getPosition(int index) const { return Vector2(posX[index], posY[index]); }
+    bool isAlive(int index) const { return alive[index] != 0; }
+    int getExperienceValue(int index) const { return experienceValue[index]; }
+    int getMaterialValue(int index) const { return materialValue[index]; }
+
+private:
+    void initSlot(int index, Vector2 pos, int experienceValue, int materialValue);
+    void moveSlot(int from, int to);
+    float drawRadius(int index) const;
+
+    PickupKind kind;
+    float baseRadius;
+    float maxLifetime;
+    float bobSpeed;
+    float bobAmplitude;
+
+    int count = 0;
+
+    // Hot: everything updateRange() touches
+    std::vector<float> posX, posY;
+    std::vector<float> lifetime;
+    std::vector<float> bobPhase;
+    std::vector<uint8_t> magnetized;
+    std::vector<uint8_t> alive;
+
+    // Render interpolation
+    std::vector<float> prevX, prevY;
+
+    // Cold
+    std::vector<int> experienceValue;
+    std::vector<int> materialValue;
+    std::vector<uint16_t> weight; // drops merged into this pickup, drives its size
+};
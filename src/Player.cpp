@@ -1,10 +1,14 @@
 #include "Player.h"
+#include "Profiler.h"
+#include "TextureCache.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
+#include "Random.h"
+#include "Logger.h"
 #include <cmath>
-#include <iostream>
-#include <SDL2/SDL_image.h>
 
 Player::Player(float x, float y) 
-    : position(x, y), velocity(0, 0), shootDirection(1, 0), 
+    : position(x, y), previousPosition(x, y), velocity(0, 0), shootDirection(1, 0), 
       radius(20), health(100), shield(100), shootCooldown(0.15f), timeSinceLastShot(0),
       experience(0), level(1), healthRegenTimer(0), healthRegenAccumulator(0.0f), playerTexture(nullptr) {
     // Initialize health to match max health
@@ -19,25 +23,17 @@ Player::Player(float x, float y)
     addWeapon(std::make_unique<Weapon>(WeaponType::ORBITING_BRICK, WeaponTier::TIER_1));
 }
 
-void Player::initialize(SDL_Renderer* renderer) {
+Player::~Player() {
+    TextureCache::instance().release(playerTexture);
+}
+
+void Player::initialize() {
     // Load brick character sprite
-    SDL_Surface* surface = IMG_Load("assets/character/brick.png");
-    if (!surface) {
-        std::cout << "Failed to load brick.png! SDL_image Error: " << IMG_GetError() << std::endl;
-        return;
-    }
-    
-    playerTexture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    
-    if (!playerTexture) {
-        std::cout << "Failed to create texture from brick.png! SDL Error: " << SDL_GetError() << std::endl;
-    } else {
-        std::cout << "Successfully loaded brick character sprite!" << std::endl;
-    }
+    playerTexture = TextureCache::instance().acquire("assets/character/brick.png");
 }
 
 void Player::update(float deltaTime) {
+    PROFILE_SCOPE("Player::update");
     position += velocity * deltaTime;
     
     if (position.x < radius) position.x = radius;
@@ -82,14 +78,16 @@ void Player::update(float deltaTime) {
     }
 }
 
-void Player::render(SDL_Renderer* renderer) {
-    int centerX = (int)position.x;
-    int centerY = (int)position.y;
+void Player::render(SDL_Renderer* renderer, float alpha) {
+    PROFILE_SCOPE("Player::render");
+    Vector2 drawPos = Vector2::lerp(previousPosition, position, alpha);
+    int centerX = (int)drawPos.x;
+    int centerY = (int)drawPos.y;
     
     if (playerTexture) {
         // Get texture dimensions
-        int textureWidth, textureHeight;
-        SDL_QueryTexture(playerTexture, nullptr, nullptr, &textureWidth, &textureHeight);
+        int textureWidth = 0, textureHeight = 0;
+        TextureCache::instance().getSize(playerTexture, textureWidth, textureHeight);
         
         // Scale the brick sprite appropriately
         float scale = 0.8f; // Adjust size as needed
@@ -105,19 +103,12 @@ void Player::render(SDL_Renderer* renderer) {
         };
         
         // Render the brick sprite
-        SDL_RenderCopy(renderer, playerTexture, nullptr, &destRect);
+        SpriteBatch::instance().copy(playerTexture, nullptr, destRect);
     } else {
         // Fallback to orange circle if texture fails to load
-        SDL_SetRenderDrawColor(renderer, 255, 200, 100, 255);
         int r = (int)radius;
         
-        for (int x = -r; x <= r; x++) {
-            for (int y = -r; y <= r; y++) {
-                if (x*x + y*y <= r*r) {
-                    SDL_RenderDrawPoint(renderer, centerX + x, centerY + y);
-                }
-            }
-        }
+        PrimitiveCache::instance().drawCircle(centerX, centerY, r, { 255, 200, 100, 255 });
     }
     
     // Remove the orange direction line - user doesn't want it
@@ -127,13 +118,12 @@ void Player::render(SDL_Renderer* renderer) {
     //                   centerY + shootDirection.y * 30);
     
     // Draw pickup range indicator (faint circle)
-    SDL_SetRenderDrawColor(renderer, 100, 255, 100, 30);
     int pickupR = (int)stats.pickupRange;
     for (int angle = 0; angle < 360; angle += 10) {
         float rad = angle * M_PI / 180.0f;
         int x1 = centerX + cos(rad) * pickupR;
         int y1 = centerY + sin(rad) * pickupR;
-        SDL_RenderDrawPoint(renderer, x1, y1);
+        SpriteBatch::instance().drawPoint(x1, y1, { 100, 255, 100, 30 });
     }
 }
 
@@ -154,6 +144,10 @@ void Player::handleInput(const Uint8* keyState) {
     }
 }
 
+void Player::setMoveInput(const Vector2& direction) {
+    velocity = direction * stats.moveSpeed;
+}
+
 void Player::updateShootDirection(const Vector2& mousePosition) {
     Vector2 direction = mousePosition - position;
     float length = direction.length();
@@ -175,7 +169,7 @@ void Player::gainExperience(int exp) {
 
 void Player::levelUp() {
     level++;
-    std::cout << "Level up! Now level " << level << std::endl;
+    LOG_INFO(LogCategory::PLAYER, "Level up! Now level %d", level);
     
     // Brotato-style: +1 Max HP per level
     stats.maxHealth += 1;
@@ -183,16 +177,16 @@ void Player::levelUp() {
     // Add weapons at certain levels for testing
     if (level == 2 && weapons.size() < MAX_WEAPONS) {
         addWeapon(std::make_unique<Weapon>(WeaponType::MELEE_STICK, WeaponTier::TIER_1));
-        std::cout << "Got Brick on Stick!" << std::endl;
+        LOG_INFO(LogCategory::PLAYER, "Got Brick on Stick!");
     } else if (level == 3 && weapons.size() < MAX_WEAPONS) {
         addWeapon(std::make_unique<Weapon>(WeaponType::SMG, WeaponTier::TIER_1));
-        std::cout << "Got SMG!" << std::endl;
+        LOG_INFO(LogCategory::PLAYER, "Got SMG!");
     } else if (level == 4 && weapons.size() < MAX_WEAPONS) {
         addWeapon(std::make_unique<Weapon>(WeaponType::SHOTGUN, WeaponTier::TIER_1));
-        std::cout << "Got Shotgun!" << std::endl;
+        LOG_INFO(LogCategory::PLAYER, "Got Shotgun!");
     } else if (level == 5 && weapons.size() < MAX_WEAPONS) {
         addWeapon(std::make_unique<Weapon>(WeaponType::SNIPER, WeaponTier::TIER_1));
-        std::cout << "Got Sniper Rifle!" << std::endl;
+        LOG_INFO(LogCategory::PLAYER, "Got Sniper Rifle!");
     }
     
     // In Brotato, upgrades are chosen by the player at wave end
@@ -215,9 +209,9 @@ void Player::takeDamage(int damage) {
     
     // Check dodge chance
     if (stats.dodgeChance > 0) {
-        float dodgeRoll = (rand() % 100) / 100.0f;
+        float dodgeRoll = rng(RandomStream::COMBAT).nextFloat();
         if (dodgeRoll < stats.dodgeChance / 100.0f) {
-            std::cout << "Dodged!" << std::endl;
+            LOG_DEBUG(LogCategory::COMBAT, "Dodged!");
             return; // Dodged the attack
         }
     }
@@ -277,24 +271,19 @@ void Player::applyFireRateBoost(float multiplier, float durationSeconds) {
 
 void Player::addWeapon(std::unique_ptr<Weapon> weapon) {
     if (weapons.size() < MAX_WEAPONS) {
+        weapon->initialize();
         weapons.push_back(std::move(weapon));
     }
 }
 
-void Player::addWeapon(std::unique_ptr<Weapon> weapon, SDL_Renderer* renderer) {
-    if (weapons.size() < MAX_WEAPONS) {
-        weapon->initialize(renderer);
-        weapons.push_back(std::move(weapon));
-    }
-}
-
-void Player::initializeWeapons(SDL_Renderer* renderer) {
+void Player::initializeWeapons() {
     for (auto& weapon : weapons) {
-        weapon->initialize(renderer);
+        weapon->initialize();
     }
 }
 
-void Player::updateWeapons(float deltaTime, std::vector<std::unique_ptr<Bullet>>& bullets) {
+void Player::updateWeapons(float deltaTime, BulletPool& bullets) {
+    PROFILE_SCOPE("Player::updateWeapons");
     if (weapons.empty()) return;
     
     // Calculate positioning for multiple weapons
@@ -314,8 +303,10 @@ void Player::updateWeapons(float deltaTime, std::vector<std::unique_ptr<Bullet>>
     }
 }
 
-void Player::renderWeapons(SDL_Renderer* renderer) {
+void Player::renderWeapons(SDL_Renderer* renderer, float alpha) {
+    PROFILE_SCOPE("Player::renderWeapons");
     if (weapons.empty()) return;
+    Vector2 drawPos = Vector2::lerp(previousPosition, position, alpha);
     
     // Calculate positions and render
     int numWeapons = weapons.size();
@@ -323,12 +314,12 @@ void Player::renderWeapons(SDL_Renderer* renderer) {
     for (int i = 0; i < numWeapons; i++) {
         Vector2 weaponPos;
         if (weapons[i]->isOrbitingWeapon()) {
-            weaponPos = weapons[i]->getOrbitingPosition(position);
+            weaponPos = weapons[i]->getOrbitingPosition(drawPos);
         } else {
             float angleOffset = (2.0f * M_PI * i) / numWeapons;
             float positionAngle = angleOffset;
             Vector2 offsetDirection(cos(positionAngle), sin(positionAngle));
-            weaponPos = position + offsetDirection * circleRadius;
+            weaponPos = drawPos + offsetDirection * circleRadius;
         }
         Vector2 weaponDirection = shootDirection;
         weapons[i]->render(renderer, weaponPos, weaponDirection);
@@ -28,25 +28,28 @@ struct PlayerStats {
 class Player {
 public:
     Player(float x, float y);
+    ~Player();
     
-    // Initialize player with renderer for texture loading
-    void initialize(SDL_Renderer* renderer);
+    // Acquire the player sprite from the shared texture cache
+    void initialize();
     
     void update(float deltaTime);
-    void render(SDL_Renderer* renderer);
+    void render(SDL_Renderer* renderer, float alpha);
     void handleInput(const Uint8* keyState);
+    // Same as handleInput for a scripted driver: each axis in -1..1
+    void setMoveInput(const Vector2& direction);
     void updateShootDirection(const Vector2& mousePosition);
     void gainExperience(int exp);
     void levelUp();
     
     // Weapon management
     void addWeapon(std::unique_ptr<Weapon> weapon);
-    void addWeapon(std::unique_ptr<Weapon> weapon, SDL_Renderer* renderer);
-    void updateWeapons(float deltaTime, std::vector<std::unique_ptr<Bullet>>& bullets);
-    void renderWeapons(SDL_Renderer* renderer);
-    void initializeWeapons(SDL_Renderer* renderer);
+    void updateWeapons(float deltaTime, BulletPool& bullets);
+    void renderWeapons(SDL_Renderer* renderer, float alpha);
+    void initializeWeapons();
     
     Vector2 getPosition() const { return position; }
+    void storePreviousPosition() { previousPosition = position; }
     float getRadius() const { return radius; }
     int getHealth() const { return health; }
     void takeDamage(int damage);
@@ -64,6 +67,7 @@ public:
     void gainMaterials(int amount) { stats.materials += amount; }
     
     // Weapon getters
+    static const int MAX_WEAPONS = 6;
     int getWeaponCount() const { return weapons.size(); }
     const std::vector<std::unique_ptr<Weapon>>& getWeapons() const { return weapons; }
     const Weapon* getWeapon(int index) const { 
@@ -87,6 +91,7 @@ public:
     
 private:
     Vector2 position;
+    Vector2 previousPosition; // for render interpolation
     Vector2 velocity;
     Vector2 shootDirection;
     float radius;
@@ -104,7 +109,6 @@ private:
     
     // Weapon inventory (max 6 weapons like Brotato)
     std::vector<std::unique_ptr<Weapon>> weapons;
-    static const int MAX_WEAPONS = 6;
     
     // Player sprite
     SDL_Texture* playerTexture;
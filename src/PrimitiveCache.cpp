@@ -0,0 +1,107 @@
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
+#include "Logger.h"
+#include <cmath>
+
+PrimitiveCache& PrimitiveCache::instance() {
+    static PrimitiveCache cache;
+    return cache;
+}
+
+void PrimitiveCache::init(SDL_Renderer* sdlRenderer) {
+    renderer = sdlRenderer;
+}
+
+void PrimitiveCache::preloadCircles(const std::vector<int>& radii) {
+    if (!renderer) return;
+    for (int radius : radii) {
+        getCircle(radius);
+    }
+}
+
+void PrimitiveCache::clear() {
+    for (SDL_Texture* texture : textures) {
+        SDL_DestroyTexture(texture);
+    }
+    textures.clear();
+    circles.clear();
+    rings.clear();
+}
+
+SDL_Texture* PrimitiveCache::createTexture(int size, const std::vector<Uint8>& coverage) {
+    // White RGBA; the draw color is applied later with color/alpha mod
+    std::vector<Uint8> pixels(size * size * 4, 255);
+    for (int i = 0; i < size * size; ++i) {
+        pixels[i * 4 + 3] = coverage[i];
+    }
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, size, size);
+    if (!texture) {
+        LOG_ERROR(LogCategory::ASSETS, "Unable to create primitive texture! SDL Error: %s", SDL_GetError());
+        return nullptr;
+    }
+    SDL_UpdateTexture(texture, nullptr, pixels.data(), size * 4);
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    textures.push_back(texture);
+    return texture;
+}
+
+SDL_Texture* PrimitiveCache::getCircle(int radius) {
+    auto it = circles.find(radius);
+    if (it != circles.end()) {
+        return it->second;
+    }
+
+    int size = radius * 2 + 1;
+    std::vector<Uint8> coverage(size * size, 0);
+    for (int y = -radius; y <= radius; ++y) {
+        for (int x = -radius; x <= radius; ++x) {
+            if (x * x + y * y <= radius * radius) {
+                coverage[(y + radius) * size + (x + radius)] = 255;
+            }
+        }
+    }
+
+    SDL_Texture* texture = createTexture(size, coverage);
+    circles[radius] = texture;
+    return texture;
+}
+
+SDL_Texture* PrimitiveCache::getRing(int innerRadius, int outerRadius) {
+    int key = (innerRadius << 16) | outerRadius;
+    auto it = rings.find(key);
+    if (it != rings.end()) {
+        return it->second;
+    }
+
+    int size = outerRadius * 2 + 1;
+    std::vector<Uint8> coverage(size * size, 0);
+    for (int y = -outerRadius; y <= outerRadius; ++y) {
+        for (int x = -outerRadius; x <= outerRadius; ++x) {
+            float distance = std::sqrt((float)(x * x + y * y));
+            if (distance <= outerRadius && distance > innerRadius) {
+                coverage[(y + outerRadius) * size + (x + outerRadius)] = 255;
+            }
+        }
+    }
+
+    SDL_Texture* texture = createTexture(size, coverage);
+    rings[key] = texture;
+    return texture;
+}
+
+void PrimitiveCache::drawTinted(SDL_Texture* texture, int centerX, int centerY, int halfSize, SDL_Color color) {
+    if (!texture) return;
+    SDL_Rect dst = { centerX - halfSize, centerY - halfSize, halfSize * 2 + 1, halfSize * 2 + 1 };
+    SpriteBatch::instance().copy(texture, nullptr, dst, color);
+}
+
+void PrimitiveCache::drawCircle(int centerX, int centerY, int radius, SDL_Color color) {
+    if (!renderer || radius < 0) return;
+    drawTinted(getCircle(radius), centerX, centerY, radius, color);
+}
+
+void PrimitiveCache::drawRing(int centerX, int centerY, int innerRadius, int outerRadius, SDL_Color color) {
+    if (!renderer || outerRadius <= innerRadius) return;
+    drawTinted(getRing(innerRadius, outerRadius), centerX, centerY, outerRadius, color);
+}
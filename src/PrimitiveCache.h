@@ -0,0 +1,41 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <unordered_map>
+#include <vector>
+
+// Filled circles and rings rasterised once into white textures and drawn with
+// a single tinted SDL_RenderCopy, instead of one SDL_RenderDrawPoint per pixel.
+// The shapes cover exactly the pixels the old point loops did, so swapping a
+// loop for a draw call does not change how anything looks.
+class PrimitiveCache {
+public:
+    static PrimitiveCache& instance();
+
+    void init(SDL_Renderer* renderer);
+    // Rasterise the sizes the game uses up front so the first frame does no uploads
+    void preloadCircles(const std::vector<int>& radii);
+    void clear();
+
+    // Pixels with x*x + y*y <= radius*radius around (centerX, centerY)
+    void drawCircle(int centerX, int centerY, int radius, SDL_Color color);
+    // Pixels with innerRadius < distance <= outerRadius (soft halo around a circle)
+    void drawRing(int centerX, int centerY, int innerRadius, int outerRadius, SDL_Color color);
+
+    int getTextureCount() const { return (int)textures.size(); }
+
+private:
+    PrimitiveCache() = default;
+    PrimitiveCache(const PrimitiveCache&) = delete;
+    PrimitiveCache& operator=(const PrimitiveCache&) = delete;
+
+    SDL_Texture* getCircle(int radius);
+    SDL_Texture* getRing(int innerRadius, int outerRadius);
+    SDL_Texture* createTexture(int size, const std::vector<Uint8>& coverage);
+    void drawTinted(SDL_Texture* texture, int centerX, int centerY, int halfSize, SDL_Color color);
+
+    SDL_Renderer* renderer = nullptr;
+    // Circles keyed by radius, rings by (inner << 16 | outer)
+    std::unordered_map<int, SDL_Texture*> circles;
+    std::unordered_map<int, SDL_Texture*> rings;
+    std::vector<SDL_Texture*> textures;
+};
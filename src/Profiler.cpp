@@ -0,0 +1,90 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : msPerCounter(1000.0 / (double)SDL_GetPerformanceFrequency()) {
+    sections.reserve(MAX_SECTIONS);
+}
+
+int Profiler::registerSection(const char* name) {
+    std::lock_guard<std::mutex> lock(registerMutex);
+    if ((int)sections.size() >= MAX_SECTIONS) return -1;
+    Section section;
+    section.name = name;
+    sections.push_back(section);
+    return (int)sections.size() - 1;
+}
+
+Profiler::ThreadTotals& Profiler::registerThread() {
+    std::lock_guard<std::mutex> lock(registerMutex);
+    threads.push_back(std::make_unique<ThreadTotals>());
+    threadTotals = threads.back().get();
+    return *threadTotals;
+}
+
+void Profiler::endFrame() {
+    std::lock_guard<std::mutex> lock(registerMutex);
+    for (int i = 0; i < (int)sections.size(); ++i) {
+        Uint64 frameCounter = 0;
+        int frameCalls = 0;
+        // Workers finished their chunks before the parallel loop returned, so their totals are settled
+        for (auto& totals : threads) {
+            frameCounter += totals->counter[i];
+            frameCalls += totals->calls[i];
+            totals->counter[i] = 0;
+            totals->calls[i] = 0;
+        }
+        sections[i].historyMs[historyIndex] = (float)(frameCounter * msPerCounter);
+        sections[i].lastCalls = frameCalls;
+    }
+    historyIndex = (historyIndex + 1) % HISTORY_FRAMES;
+    historyCount = std::min(historyCount + 1, HISTORY_FRAMES);
+}
+
+void Profiler::collectStats(std::vector<ProfileSectionStats>& out) const {
+    out.clear();
+    if (historyCount == 0) return;
+
+    int lastIndex = (historyIndex + HISTORY_FRAMES - 1) % HISTORY_FRAMES;
+    float sorted[HISTORY_FRAMES];
+    for (const auto& section : sections) {
+        std::copy(section.historyMs, section.historyMs + historyCount, sorted);
+        std::sort(sorted, sorted + historyCount);
+
+        double sum = 0.0;
+        for (int i = 0; i < historyCount; ++i) {
+            sum += sorted[i];
+        }
+        int p99Index = std::min(historyCount - 1, (historyCount * 99) / 100);
+
+        ProfileSectionStats stats;
+        stats.name = section.name;
+        stats.lastMs = section.historyMs[lastIndex];
+        stats.minMs = sorted[0];
+        stats.avgMs = sum / historyCount;
+        stats.p99Ms = sorted[p99Index];
+        stats.calls = section.lastCalls;
+        out.push_back(stats);
+    }
+}
+
+void Profiler::logSummary() const {
+    std::vector<ProfileSectionStats> stats;
+    collectStats(stats);
+    if (stats.empty()) return;
+
+    std::cout << "Profiler (last " << historyCount << " frames, ms): name / min / avg / p99" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& s : stats) {
+        std::cout << "  " << std::left << std::setw(28) << s.name << std::right
+                  << std::setw(9) << s.minMs << std::setw(9) << s.avgMs << std::setw(9) << s.p99Ms << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// PROFILE_SCOPE("Name") times the enclosing block and adds it to that section's
+// total for the current frame. Define BROTATO_PROFILING (CMake option of the
+// same name) to compile the timers in; without it the macro expands to nothing.
+#ifdef BROTATO_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) \
+    static const int PROFILE_CONCAT(profileSection_, __LINE__) = Profiler::instance().registerSection(name); \
+    ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(PROFILE_CONCAT(profileSection_, __LINE__))
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
+
+struct ProfileSectionStats {
+    const char* name;
+    double lastMs; // total of the most recent frame
+    double minMs;  // over the rolling window
+    double avgMs;
+    double p99Ms;
+    int calls;     // scopes entered in the most recent frame
+};
+
+// Per-section frame times over the last HISTORY_FRAMES frames. Sections are
+// registered once (PROFILE_SCOPE keeps the id in a function-local static) and
+// every scope on a frame adds to the same slot, so per-entity scopes show up
+// as one total per class. Each thread adds into its own totals, summed at
+// endFrame(), so scopes inside job system chunks count whatever the thread
+// count; their rows are CPU time across threads and can exceed the wall time
+// of the parallel pass around them.
+class Profiler {
+public:
+    static constexpr int HISTORY_FRAMES = 120;
+
+    static Profiler& instance();
+
+    // Thread-safe: the first thread to reach a PROFILE_SCOPE registers it
+    int registerSection(const char* name);
+    void record(int section, Uint64 elapsedCounter) {
+        ThreadTotals* totals = threadTotals ? threadTotals : &registerThread();
+        totals->counter[section] += elapsedCounter;
+        totals->calls[section]++;
+    }
+
+    // Closes the current frame: pushes every section's total into its history.
+    // Main thread only, outside parallel loops (no job may be recording)
+    void endFrame();
+
+    void collectStats(std::vector<ProfileSectionStats>& out) const;
+    void logSummary() const;
+
+private:
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static constexpr int MAX_SECTIONS = 128;
+
+    struct Section {
+        const char* name;
+        int lastCalls = 0;
+        float historyMs[HISTORY_FRAMES] = {};
+    };
+
+    // One thread's running totals for the current frame
+    struct ThreadTotals {
+        Uint64 counter[MAX_SECTIONS] = {};
+        int calls[MAX_SECTIONS] = {};
+    };
+
+    ThreadTotals& registerThread();
+
+    static inline thread_local ThreadTotals* threadTotals = nullptr;
+
+    // Reserved up front and never reallocated, so a worker registering a
+    // section cannot move the ones the main thread is recording into
+    std::vector<Section> sections;
+    std::vector<std::unique_ptr<ThreadTotals>> threads; // kept after a thread exits; it just stops adding
+    std::mutex registerMutex;
+    int historyIndex = 0;  // slot the next endFrame() writes
+    int historyCount = 0;  // filled slots, up to HISTORY_FRAMES
+    double msPerCounter;
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(int section)
+        : section(section), start(SDL_GetPerformanceCounter()) {}
+    ~ProfileScope() {
+        if (section >= 0) Profiler::instance().record(section, SDL_GetPerformanceCounter() - start);
+    }
+
+private:
+    int section;
+    Uint64 start;
+};
@@ -0,0 +1,69 @@
+#include "Random.h"
+#include <chrono>
+#include <random>
+
+namespace {
+    uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    inline uint32_t rotl(uint32_t x, int k) {
+        return (x << k) | (x >> (32 - k));
+    }
+}
+
+void Rng::seed(uint64_t seed) {
+    uint64_t a = splitmix64(seed);
+    uint64_t b = splitmix64(seed);
+    state[0] = static_cast<uint32_t>(a);
+    state[1] = static_cast<uint32_t>(a >> 32);
+    state[2] = static_cast<uint32_t>(b);
+    state[3] = static_cast<uint32_t>(b >> 32);
+}
+
+uint32_t Rng::next() {
+    const uint32_t result = rotl(state[1] * 5, 7) * 9;
+    const uint32_t t = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 11);
+
+    return result;
+}
+
+int Rng::rangeInt(int min, int max) {
+    if (max <= min) return min;
+    // Multiply-shift maps 32 random bits onto the range without a modulo
+    uint32_t span = static_cast<uint32_t>(max - min) + 1u;
+    return min + static_cast<int>((static_cast<uint64_t>(next()) * span) >> 32);
+}
+
+Random& Random::instance() {
+    static Random random;
+    return random;
+}
+
+Random::Random() {
+    seed(seedFromEntropy());
+}
+
+void Random::seed(uint64_t seed) {
+    masterSeed = seed;
+    uint64_t mix = seed;
+    for (auto& stream : streams) {
+        stream.seed(splitmix64(mix));
+    }
+}
+
+uint64_t Random::seedFromEntropy() {
+    std::random_device rd;
+    uint64_t seed = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+    return seed ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+
+// Independent random streams, one per gameplay system, so adding a roll in
+// one system does not shift the sequence every other system sees.
+enum class RandomStream {
+    SPAWN,     // enemy spawn positions and types, boss choice
+    BOOSTERS,  // booster spawn positions
+    DROPS,     // material drops on kill
+    COMBAT,    // crits, dodges
+    WEAPONS,   // spread and inaccuracy
+    SHOP,      // shop offers
+    BOSS,      // boss-internal choices (fractal node targeting, centipede fire timing)
+    VISUAL,    // cosmetic only (bob phases, colors)
+    COUNT
+};
+
+// xoshiro128** - small, fast and good enough for gameplay. Seeded through
+// splitmix64 so nearby seeds still give unrelated sequences.
+class Rng {
+public:
+    Rng() { seed(0); }
+
+    void seed(uint64_t seed);
+    uint32_t next();
+
+    // [0, 1)
+    float nextFloat() { return (next() >> 8) * (1.0f / 16777216.0f); }
+    // [min, max)
+    float range(float min, float max) { return min + (max - min) * nextFloat(); }
+    // [min, max] inclusive, like std::uniform_int_distribution
+    int rangeInt(int min, int max);
+    bool chance(float probability) { return nextFloat() < probability; }
+
+private:
+    uint32_t state[4];
+};
+
+// Owner of every stream. One master seed derives all of them, so a run is
+// reproduced exactly by passing the same seed (printed at startup, --seed).
+class Random {
+public:
+    static Random& instance();
+
+    void seed(uint64_t masterSeed);
+    uint64_t getSeed() const { return masterSeed; }
+    // Non-deterministic seed for normal play
+    static uint64_t seedFromEntropy();
+
+    Rng& stream(RandomStream which) { return streams[static_cast<int>(which)]; }
+
+private:
+    Random();
+
+    uint64_t masterSeed = 0;
+    Rng streams[static_cast<int>(RandomStream::COUNT)];
+};
+
+// Shorthand used at call sites: rng(RandomStream::COMBAT).chance(critChance)
+inline Rng& rng(RandomStream which) {
+    return Random::instance().stream(which);
+}
@@ -1,13 +1,14 @@
 #include "Shop.h"
 #include "Player.h"
 #include "Game.h"
-#include <random>
+#include "TextureCache.h"
+#include "Random.h"
+#include "Logger.h"
 #include <algorithm>
-#include <iostream>
 #include <cmath>
 #include <string>
+#include <cstdio>
 #include <cstring>
-#include <SDL2/SDL_image.h>
 
 std::string ShopItem::getWeaponName(WeaponType wType, WeaponTier wTier) {
     std::string baseName;
@@ -85,53 +86,55 @@ Shop::Shop() : active(false), rerollCount(0), currentWave(0), selectedItem(0), h
 
 Shop::~Shop() {
     unloadAssets();
+    if (panelCache) {
+        SDL_DestroyTexture(panelCache);
+    }
 }
 
-void Shop::loadAssets(SDL_Renderer* renderer) {
+void Shop::loadAssets() {
     // Load UI textures. These are optional; if missing we fall back to rects.
-    texCardNormal = loadTexture("assets/ui/card_normal.png", renderer);
-    texCardSelected = loadTexture("assets/ui/card_selected.png", renderer);
-    texCardLocked = loadTexture("assets/ui/card_locked.png", renderer);
-    texCoin = loadTexture("assets/ui/coin.png", renderer);
-    texLock = loadTexture("assets/ui/lock.png", renderer);
-    texLockLocked = loadTexture("assets/ui/lock_locked.png", renderer);
-    texReroll = loadTexture("assets/ui/reroll.png", renderer);
-    texWeaponPistol = loadTexture("assets/weapons/pistol.png", renderer);
-    texWeaponSMG = loadTexture("assets/weapons/smg.png", renderer);
-    texWeaponShotgun = loadTexture("assets/weapons/shotgun.png", renderer);
-    texWeaponSniper = loadTexture("assets/weapons/sniper2.png", renderer);
-    texHealthRegen = loadTexture("assets/ui/heart.png", renderer);
+    texCardNormal = loadTexture("assets/ui/card_normal.png");
+    texCardSelected = loadTexture("assets/ui/card_selected.png");
+    texCardLocked = loadTexture("assets/ui/card_locked.png");
+    texCoin = loadTexture("assets/ui/coin.png");
+    texLock = loadTexture("assets/ui/lock.png");
+    texLockLocked = loadTexture("assets/ui/lock_locked.png");
+    texReroll = loadTexture("assets/ui/reroll.png");
+    texWeaponPistol = loadTexture("assets/weapons/pistol.png");
+    texWeaponSMG = loadTexture("assets/weapons/smg.png");
+    texWeaponShotgun = loadTexture("assets/weapons/shotgun.png");
+    texWeaponSniper = loadTexture("assets/weapons/sniper2.png");
+    texHealthRegen = loadTexture("assets/ui/heart.png");
 }
 
 void Shop::unloadAssets() {
-    auto destroyIf = [](SDL_Texture*& t) {
-        if (t) { SDL_DestroyTexture(t); t = nullptr; }
+    auto releaseIf = [](SDL_Texture*& t) {
+        TextureCache::instance().release(t);
+        t = nullptr;
     };
-    destroyIf(texCardNormal);
-    destroyIf(texCardSelected);
-    destroyIf(texCardLocked);
-    destroyIf(texCoin);
-    destroyIf(texLock);
-    destroyIf(texLockLocked);
-    destroyIf(texReroll);
-    destroyIf(texWeaponPistol);
-    destroyIf(texWeaponSMG);
-    destroyIf(texWeaponShotgun);
-    destroyIf(texWeaponSniper);
-    destroyIf(texHealthRegen);
+    releaseIf(texCardNormal);
+    releaseIf(texCardSelected);
+    releaseIf(texCardLocked);
+    releaseIf(texCoin);
+    releaseIf(texLock);
+    releaseIf(texLockLocked);
+    releaseIf(texReroll);
+    releaseIf(texWeaponPistol);
+    releaseIf(texWeaponSMG);
+    releaseIf(texWeaponShotgun);
+    releaseIf(texWeaponSniper);
+    releaseIf(texHealthRegen);
 }
 
 void Shop::generateItems(int waveNumber, int playerLuck) {
     items.clear();
     
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    Rng& gen = rng(RandomStream::SHOP);
     
     // Generate 4 random items (mix of weapons and items)
     for (int i = 0; i < MAX_SHOP_ITEMS; i++) {
         // 25% chance for items, 75% chance for weapons
-        std::uniform_int_distribution<int> itemTypeDist(0, 3);
-        bool generateItem = (itemTypeDist(gen) == 0); // 1 in 4 chance for items
+        bool generateItem = (gen.rangeInt(0, 3) == 0); // 1 in 4 chance for items
         
 
         
@@ -147,8 +150,7 @@ void Shop::generateItems(int waveNumber, int playerLuck) {
             if (waveNumber >= 6) availableLevels.push_back(3);
             if (waveNumber >= 10) availableLevels.push_back(4);
             
-            std::uniform_int_distribution<int> levelDist(0, availableLevels.size() - 1);
-            int itemLevel = availableLevels[levelDist(gen)];
+            int itemLevel = availableLevels[gen.rangeInt(0, (int)availableLevels.size() - 1)];
             
             // Only add if this item level can appear at this wave
             if (canItemAppear(itemType, itemLevel, waveNumber)) {
@@ -164,9 +166,8 @@ void Shop::generateItems(int waveNumber, int playerLuck) {
         
         if (!generateItem) {
             // Generate weapon
-            std::uniform_int_distribution<int> weaponDist(0, 3); // 0-3 for 4 weapon types
             WeaponType weaponType;
-            switch (weaponDist(gen)) {
+            switch (gen.rangeInt(0, 3)) { // 0-3 for 4 weapon types
                 case 0: weaponType = WeaponType::PISTOL; break;
                 case 1: weaponType = WeaponType::SMG; break;
                 case 2: weaponType = WeaponType::SHOTGUN; break;
@@ -182,8 +183,7 @@ void Shop::generateItems(int waveNumber, int playerLuck) {
             if (waveNumber >= 4) availableTiers.push_back(WeaponTier::TIER_3);
             if (waveNumber >= 8) availableTiers.push_back(WeaponTier::TIER_4);
             
-            std::uniform_int_distribution<int> tierDist(0, availableTiers.size() - 1);
-            WeaponTier tier = availableTiers[tierDist(gen)];
+            WeaponTier tier = availableTiers[gen.rangeInt(0, (int)availableTiers.size() - 1)];
             
             int price = calculateItemPrice(weaponType, tier, waveNumber);
             items.emplace_back(weaponType, tier, price);
@@ -197,8 +197,9 @@ void Shop::openShop(int waveNumber) {
     rerollCount = 0;
     selectedItem = 0;
     generateItems(waveNumber);
+    invalidate();
     
-    std::cout << "Shop opened after wave " << waveNumber << std::endl;
+    LOG_INFO(LogCategory::SHOP, "Shop opened after wave %d", waveNumber);
 }
 
 void Shop::closeShop() {
@@ -208,7 +209,59 @@ void Shop::closeShop() {
 
 void Shop::render(SDL_Renderer* renderer, int windowWidth, int windowHeight) {
     if (!active) return;
-    
+
+    // Material count also changes what the cards show (BUY / NEED, reroll button)
+    int materials = gameRef ? gameRef->getPlayerMaterials() : 0;
+    if (materials != cachedMaterials || selectedOwnedWeapon != cachedOwnedWeapon) {
+        panelDirty = true;
+    }
+
+    if (!panelCache && SDL_RenderTargetSupported(renderer)) {
+        panelCache = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, windowWidth, windowHeight);
+        if (panelCache) {
+            SDL_SetTextureBlendMode(panelCache, SDL_BLENDMODE_BLEND);
+        } else {
+            LOG_WARN(LogCategory::SHOP, "Unable to create shop cache texture! SDL Error: %s", SDL_GetError());
+        }
+        panelDirty = true;
+    }
+
+    if (panelCache) {
+        if (panelDirty) {
+            SDL_SetRenderTarget(renderer, panelCache);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+            SDL_RenderClear(renderer);
+            renderPanel(renderer, windowWidth, windowHeight);
+            SDL_SetRenderTarget(renderer, nullptr);
+            panelDirty = false;
+            cachedMaterials = materials;
+            cachedOwnedWeapon = selectedOwnedWeapon;
+        }
+        SDL_RenderCopy(renderer, panelCache, nullptr, nullptr);
+    } else {
+        renderPanel(renderer, windowWidth, windowHeight);
+    }
+
+    // Hover highlight goes over the cached panel, so moving the mouse never redraws it
+    if (hoveredItem >= 0 && hoveredItem < (int)items.size() && hoveredItem != selectedItem) {
+        SDL_Rect card = cardRect(hoveredItem, windowWidth, windowHeight);
+        SDL_SetRenderDrawColor(renderer, 120, 160, 255, 40);
+        SDL_RenderFillRect(renderer, &card);
+        SDL_SetRenderDrawColor(renderer, 200, 200, 255, 255);
+        SDL_RenderDrawRect(renderer, &card);
+    }
+}
+
+SDL_Rect Shop::cardRect(int index, int windowWidth, int windowHeight) const {
+    // Same layout as renderPanel and handleMouseInput
+    int shopWidth = windowWidth - (2 * 50) - 350 - 20;
+    int shopY = (windowHeight - 700) / 2;
+    int itemSpacing = 20;
+    int itemWidth = (shopWidth - 40 - (3 * itemSpacing)) / 4;
+    return { 50 + 20 + index * (itemWidth + itemSpacing), shopY + 120, itemWidth, 300 };
+}
+
+void Shop::renderPanel(SDL_Renderer* renderer, int windowWidth, int windowHeight) {
     // Proper shop layout - centered with room for stats panel on right
     int statsWidth = 350; // Fixed width for stats panel
     int margin = 50; // Margins around elements
@@ -235,8 +288,9 @@ void Shop::render(SDL_Renderer* renderer, int windowWidth, int windowHeight) {
     // Current materials display
     renderTTFText(renderer, "MATERIALS:", shopX + shopWidth - 200, shopY + 20, white, 16);
     if (gameRef) {
-        std::string materialsText = std::to_string(gameRef->getPlayerMaterials());
-        renderTTFText(renderer, materialsText.c_str(), shopX + shopWidth - 70, shopY + 20, white, 20);
+        char materialsText[16];
+        snprintf(materialsText, sizeof(materialsText), "%d", gameRef->getPlayerMaterials());
+        renderTTFText(renderer, materialsText, shopX + shopWidth - 70, shopY + 20, white, 20);
     }
     
     // Instructions
@@ -254,9 +308,9 @@ void Shop::render(SDL_Renderer* renderer, int windowWidth, int windowHeight) {
         int x = gridStartX + i * (itemWidth + itemSpacing);
         int y = gridStartY;
         
-        bool hovered = (i == hoveredItem);
+        // Hover is drawn on top by render(); only the selection is part of the cached panel
         bool selected = (i == selectedItem);
-        renderShopItem(renderer, items[i], x, y, itemWidth, itemHeight, selected || hovered, i);
+        renderShopItem(renderer, items[i], x, y, itemWidth, itemHeight, selected, i);
     }
 
     // Bottom-left Items inventory section (display slots like Brotato)
@@ -333,8 +387,9 @@ void Shop::render(SDL_Renderer* renderer, int windowWidth, int windowHeight) {
     
     // Use TTF text for reroll button
     renderTTFText(renderer, "REROLL", rerollButton.x + 10, rerollButton.y + 8, white, 14);
-    std::string rerollPriceText = std::to_string(rerollPrice);
-    renderTTFText(renderer, rerollPriceText.c_str(), rerollButton.x + 10, rerollButton.y + 25, white, 14);
+    char rerollPriceText[16];
+    snprintf(rerollPriceText, sizeof(rerollPriceText), "%d", rerollPrice);
+    renderTTFText(renderer, rerollPriceText, rerollButton.x + 10, rerollButton.y + 25, white, 14);
     
     // Close button - move to bottom right
     SDL_Rect closeButton = {shopX + shopWidth - 200, bottomY, 150, 50};
@@ -584,17 +639,18 @@ void Shop::buyItem(int index, Player& player) {
     if (player.getStats().materials >= item.price) {
         if (item.type == ShopItemType::WEAPON) {
             // Check if player can hold more weapons
-            // Create and add weapon to player with renderer for sprite loading
+            // Create and add weapon to player (sprite comes from the texture cache)
             auto weapon = std::make_unique<Weapon>(item.weaponType, item.tier);
-            player.addWeapon(std::move(weapon), gameRef->getRenderer());
+            player.addWeapon(std::move(weapon));
             
             // Deduct materials
             player.getStats().materials -= item.price;
             
-            std::cout << "Bought " << item.name << " for " << item.price << " materials" << std::endl;
+            LOG_INFO(LogCategory::SHOP, "Bought %s for %d materials", item.name.c_str(), item.price);
             
             // Remove item from shop
             items.erase(items.begin() + index);
+            invalidate();
         }
         else if (item.type == ShopItemType::ITEM) {
             // Handle item purchases
@@ -606,15 +662,16 @@ void Shop::buyItem(int index, Player& player) {
                 // Deduct materials
                 player.getStats().materials -= item.price;
                 
-                std::cout << "Bought " << item.name << " for " << item.price << " materials" << std::endl;
-                std::cout << "Health regeneration is now " << player.getStats().healthRegen << " HP/sec" << std::endl;
+                LOG_INFO(LogCategory::SHOP, "Bought %s for %d materials", item.name.c_str(), item.price);
+                LOG_INFO(LogCategory::SHOP, "Health regeneration is now %g HP/sec", player.getStats().healthRegen);
                 
                 // Remove item from shop
                 items.erase(items.begin() + index);
+                invalidate();
             }
         }
     } else {
-        std::cout << "Not enough materials! Need " << item.price << ", have " << player.getStats().materials << std::endl;
+        LOG_INFO(LogCategory::SHOP, "Not enough materials! Need %d, have %d", item.price, player.getStats().materials);
     }
 }
 
@@ -622,7 +679,8 @@ void Shop::lockItem(int index) {
     if (index >= items.size()) return;
     
     items[index].locked = !items[index].locked;
-    std::cout << "Item " << (items[index].locked ? "locked" : "unlocked") << std::endl;
+    invalidate();
+    LOG_INFO(LogCategory::SHOP, "Item %s", items[index].locked ? "locked" : "unlocked");
 }
 
 void Shop::reroll(Player& player, int waveNumber) {
@@ -646,10 +704,11 @@ void Shop::reroll(Player& player, int waveNumber) {
         for (int i = 0; i < lockedItems.size() && i < items.size(); i++) {
             items[i] = lockedItems[i];
         }
+        invalidate();
         
-        std::cout << "Rerolled shop for " << rerollPrice << " materials" << std::endl;
+        LOG_INFO(LogCategory::SHOP, "Rerolled shop for %d materials", rerollPrice);
     } else {
-        std::cout << "Not enough materials for reroll! Need " << rerollPrice << std::endl;
+        LOG_INFO(LogCategory::SHOP, "Not enough materials for reroll! Need %d", rerollPrice);
     }
 }
 
@@ -711,18 +770,8 @@ void Shop::renderTTFText(SDL_Renderer* renderer, const char* text, int x, int y,
     }
 }
 
-SDL_Texture* Shop::loadTexture(const char* path, SDL_Renderer* renderer) {
-    SDL_Surface* surface = IMG_Load(path);
-    if (!surface) {
-        std::cout << "Unable to load image " << path << "! SDL_image Error: " << IMG_GetError() << std::endl;
-        return nullptr;
-    }
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    if (!texture) {
-        std::cout << "Unable to create texture from " << path << "! SDL Error: " << SDL_GetError() << std::endl;
-    }
-    return texture;
+SDL_Texture* Shop::loadTexture(const char* path) {
+    return TextureCache::instance().acquire(path);
 }
 
 void Shop::handleMouseInput(int mouseX, int mouseY, bool mousePressed, Player& player) {
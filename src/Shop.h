@@ -69,7 +69,7 @@ public:
     ~Shop();
     
     void setGame(Game* game) { gameRef = game; }
-    void loadAssets(SDL_Renderer* renderer);
+    void loadAssets();
     void unloadAssets();
     
     void generateItems(int waveNumber, int playerLuck = 0);
@@ -85,6 +85,10 @@ public:
     void buyItem(int index, Player& player);
     void lockItem(int index);
     void reroll(Player& player, int waveNumber);
+
+    // The panel is drawn into an offscreen texture and reused until something
+    // it shows changes; call when the renderer reports its targets were reset
+    void invalidate() { panelDirty = true; }
     
 private:
     bool active;
@@ -93,12 +97,14 @@ private:
     int currentWave;
     
     // UI helpers
+    void renderPanel(SDL_Renderer* renderer, int windowWidth, int windowHeight);
+    SDL_Rect cardRect(int index, int windowWidth, int windowHeight) const;
     void renderShopItem(SDL_Renderer* renderer, const ShopItem& item, int x, int y, int width, int height, bool highlighted, int index);
     void renderCharacterStats(SDL_Renderer* renderer, int x, int y, int width, int height);
     void renderText(SDL_Renderer* renderer, const char* text, int x, int y, int scale = 1);
     void renderNumber(SDL_Renderer* renderer, int number, int x, int y, int scale = 1);
     void renderTTFText(SDL_Renderer* renderer, const char* text, int x, int y, SDL_Color color, int fontSize = 16);
-    SDL_Texture* loadTexture(const char* path, SDL_Renderer* renderer);
+    SDL_Texture* loadTexture(const char* path);
     
     // Shop logic
     int calculateItemPrice(WeaponType weaponType, WeaponTier tier, int waveNumber);
@@ -131,4 +137,10 @@ private:
     SDL_Texture* texWeaponShotgun = nullptr;
     SDL_Texture* texWeaponSniper = nullptr;
     SDL_Texture* texHealthRegen = nullptr;
+
+    // Cached panel (everything but the hover highlight)
+    SDL_Texture* panelCache = nullptr;
+    bool panelDirty = true;
+    int cachedMaterials = -1;
+    int cachedOwnedWeapon = -1;
 };
\ No newline at end of file
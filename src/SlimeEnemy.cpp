@@ -1,34 +1,31 @@
 #include "SlimeEnemy.h"
-#include "Bullet.h"
-#include <SDL2/SDL_image.h>
+#include "Profiler.h"
+#include "BulletPool.h"
+#include "TextureCache.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
 #include <cmath>
 #include <iostream>
 
-SlimeEnemy::SlimeEnemy(Vector2 pos, SDL_Renderer* renderer)
-    : Enemy(pos, renderer), fireCooldown(2.0f), timeSinceLastShot(0.0f), slimeTexture(nullptr) {
+SlimeEnemy::SlimeEnemy(Vector2 pos)
+    : Enemy(pos), fireCooldown(2.0f), timeSinceLastShot(0.0f), slimeTexture(nullptr) {
     // Tweak base stats to feel different
     speed = 60.0f;
     radius = 26.0f;
     damage = 8;
-    loadSprites(renderer);
+    loadSprites();
 }
 
-void SlimeEnemy::loadSprites(SDL_Renderer* renderer) {
+SlimeEnemy::~SlimeEnemy() {
+    TextureCache::instance().release(slimeTexture);
+}
+
+void SlimeEnemy::loadSprites() {
     // Use provided slime icon if available
-    SDL_Surface* surface = IMG_Load("assets/enemies/slime.png");
-    if (!surface) {
-        std::cout << "Failed to load slime.png: " << IMG_GetError() << std::endl;
-        slimeTexture = nullptr;
-        return;
-    }
-    slimeTexture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    if (!slimeTexture) {
-        std::cout << "Failed to create slime texture: " << SDL_GetError() << std::endl;
-    }
+    slimeTexture = TextureCache::instance().acquire("assets/enemies/slime.png");
 }
 
-void SlimeEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
+void SlimeEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) {
     timeSinceLastShot += deltaTime;
     if (timeSinceLastShot < fireCooldown) return;
     timeSinceLastShot = 0.0f;
@@ -39,10 +36,11 @@ void SlimeEnemy::tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vector
 
     // Shoot straight at the player with normal bullet physics
     Vector2 dir = toPlayer.normalized();
-    bullets.push_back(std::make_unique<Bullet>(position, dir, /*damage*/ 10, /*range*/ 600.0f, /*speed*/ 320.0f, BulletType::PISTOL, /*enemyOwned*/ true));
+    bullets.spawn(position, dir, /*damage*/ 10, /*range*/ 600.0f, /*speed*/ 320.0f, BulletType::PISTOL, /*enemyOwned*/ true);
 }
 
-void SlimeEnemy::update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) {
+void SlimeEnemy::update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) {
+    PROFILE_SCOPE("SlimeEnemy::update");
     // Slow homing movement
     Vector2 direction = (playerPos - position).normalized();
     velocity = direction * speed;
@@ -66,31 +64,28 @@ void SlimeEnemy::update(float deltaTime, Vector2 playerPos, std::vector<std::uni
     }
 }
 
-void SlimeEnemy::render(SDL_Renderer* renderer) {
+void SlimeEnemy::render(SDL_Renderer* renderer, float alpha) {
+    PROFILE_SCOPE("SlimeEnemy::render");
     if (!alive) return;
+    Vector2 drawPos = Vector2::lerp(previousPosition, position, alpha);
     if (slimeTexture) {
-        int w, h;
-        SDL_QueryTexture(slimeTexture, nullptr, nullptr, &w, &h);
+        int w = 0, h = 0;
+        TextureCache::instance().getSize(slimeTexture, w, h);
         float scale = 0.9f;
         int sw = (int)(w * scale);
         int sh = (int)(h * scale);
-        SDL_Rect dst{ (int)(position.x - sw/2), (int)(position.y - sh/2), sw, sh };
-        SDL_RenderCopy(renderer, slimeTexture, nullptr, &dst);
+        SDL_Rect dst{ (int)(drawPos.x - sw/2), (int)(drawPos.y - sh/2), sw, sh };
+        SpriteBatch::instance().copy(slimeTexture, nullptr, dst);
     } else {
         // fallback circle in green
-        SDL_SetRenderDrawColor(renderer, 80, 200, 80, 255);
-        int cx = (int)position.x;
-        int cy = (int)position.y;
+        int cx = (int)drawPos.x;
+        int cy = (int)drawPos.y;
         int r = (int)radius;
-        for (int x = -r; x <= r; ++x) {
-            for (int y = -r; y <= r; ++y) {
-                if (x*x + y*y <= r*r) SDL_RenderDrawPoint(renderer, cx + x, cy + y);
-            }
-        }
+        PrimitiveCache::instance().drawCircle(cx, cy, r, { 80, 200, 80, 255 });
     }
 }
 
-std::unique_ptr<Enemy> CreateSlimeEnemy(const Vector2& pos, SDL_Renderer* renderer) {
-    return std::make_unique<SlimeEnemy>(pos, renderer);
+std::unique_ptr<Enemy> CreateSlimeEnemy(const Vector2& pos) {
+    return std::make_unique<SlimeEnemy>(pos);
 }
 
@@ -1,22 +1,21 @@
 #pragma once
 #include "Enemy.h"
-#include <random>
 #include <vector>
 #include <memory>
 
-class Bullet;
+class BulletEmitter;
 
 class SlimeEnemy : public Enemy {
 public:
-    SlimeEnemy(Vector2 pos, SDL_Renderer* renderer);
-    ~SlimeEnemy() override = default;
+    explicit SlimeEnemy(Vector2 pos);
+    ~SlimeEnemy() override;
 
-    void update(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets) override;
-    void render(SDL_Renderer* renderer) override;
+    void update(float deltaTime, Vector2 playerPos, BulletEmitter& bullets) override;
+    void render(SDL_Renderer* renderer, float alpha) override;
 
 private:
-    void loadSprites(SDL_Renderer* renderer);
-    void tryFireAtPlayer(float deltaTime, Vector2 playerPos, std::vector<std::unique_ptr<Bullet>>& bullets);
+    void loadSprites();
+    void tryFireAtPlayer(float deltaTime, Vector2 playerPos, BulletEmitter& bullets);
 
     float fireCooldown;
     float timeSinceLastShot;
@@ -24,5 +23,5 @@ private:
 };
 
 // Factory helper so Game.cpp can spawn without header include order issues
-std::unique_ptr<Enemy> CreateSlimeEnemy(const Vector2& pos, SDL_Renderer* renderer);
+std::unique_ptr<Enemy> CreateSlimeEnemy(const Vector2& pos);
 
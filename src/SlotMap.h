@@ -0,0 +1,153 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Stable reference to an element of a SlotMap. The generation changes every
+// time a slot is freed, so a handle to a removed element stops resolving
+// instead of pointing at whatever reused the slot.
+struct SlotHandle {
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+    bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+// Slot map: values are stored densely (iterate them like a vector), handles
+// go through a slot table, and insert/remove are O(1). Removal swap-moves the
+// last element into the hole, so dense order is not stable and dense indices
+// are only valid until the next remove; hold a SlotHandle across frames.
+template <typename T>
+class SlotMap {
+public:
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    void reserve(size_t capacity) {
+        values.reserve(capacity);
+        denseToSlot.reserve(capacity);
+        slots.reserve(capacity);
+    }
+
+    template <typename... Args>
+    SlotHandle emplace(Args&&... args) {
+        uint32_t slotIndex;
+        if (freeHead != SlotHandle::INVALID_INDEX) {
+            slotIndex = freeHead;
+            freeHead = slots[slotIndex].nextFree;
+        } else {
+            slotIndex = static_cast<uint32_t>(slots.size());
+            slots.push_back(Slot());
+        }
+
+        Slot& slot = slots[slotIndex];
+        slot.denseIndex = static_cast<uint32_t>(values.size());
+        values.emplace_back(std::forward<Args>(args)...);
+        denseToSlot.push_back(slotIndex);
+
+        SlotHandle handle;
+        handle.index = slotIndex;
+        handle.generation = slot.generation;
+        return handle;
+    }
+
+    bool contains(SlotHandle handle) const {
+        return handle.index < slots.size()
+            && slots[handle.index].generation == handle.generation
+            && slots[handle.index].denseIndex != SlotHandle::INVALID_INDEX;
+    }
+
+    T* get(SlotHandle handle) {
+        return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+    }
+    const T* get(SlotHandle handle) const {
+        return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+    }
+
+    bool remove(SlotHandle handle) {
+        if (!contains(handle)) return false;
+        removeAt(slots[handle.index].denseIndex);
+        return true;
+    }
+
+    // Removes every element the predicate returns true for (it may mutate the
+    // element first). One pass, no compaction: each removal is a swap.
+    template <typename Predicate>
+    int removeIf(Predicate predicate) {
+        int removed = 0;
+        size_t i = 0;
+        while (i < values.size()) {
+            if (predicate(values[i])) {
+                removeAt(static_cast<uint32_t>(i));
+                removed++;
+            } else {
+                ++i;
+            }
+        }
+        return removed;
+    }
+
+    void clear() {
+        // Keep slots so outstanding handles stay invalid rather than aliasing new elements
+        for (uint32_t i = 0; i < static_cast<uint32_t>(values.size()); ++i) {
+            releaseSlot(denseToSlot[i]);
+        }
+        values.clear();
+        denseToSlot.clear();
+    }
+
+    // Dense access, for iteration and for spatial grid ids
+    T& operator[](size_t denseIndex) { return values[denseIndex]; }
+    const T& operator[](size_t denseIndex) const { return values[denseIndex]; }
+    SlotHandle handleAt(size_t denseIndex) const {
+        SlotHandle handle;
+        handle.index = denseToSlot[denseIndex];
+        handle.generation = slots[handle.index].generation;
+        return handle;
+    }
+
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    iterator begin() { return values.begin(); }
+    iterator end() { return values.end(); }
+    const_iterator begin() const { return values.begin(); }
+    const_iterator end() const { return values.end(); }
+
+private:
+    struct Slot {
+        uint32_t denseIndex = SlotHandle::INVALID_INDEX; // INVALID while free
+        uint32_t generation = 0;
+        uint32_t nextFree = SlotHandle::INVALID_INDEX;
+    };
+
+    void removeAt(uint32_t denseIndex) {
+        uint32_t slotIndex = denseToSlot[denseIndex];
+        uint32_t last = static_cast<uint32_t>(values.size()) - 1;
+        if (denseIndex != last) {
+            values[denseIndex] = std::move(values[last]);
+            denseToSlot[denseIndex] = denseToSlot[last];
+            slots[denseToSlot[denseIndex]].denseIndex = denseIndex;
+        }
+        values.pop_back();
+        denseToSlot.pop_back();
+        releaseSlot(slotIndex);
+    }
+
+    void releaseSlot(uint32_t slotIndex) {
+        Slot& slot = slots[slotIndex];
+        slot.denseIndex = SlotHandle::INVALID_INDEX;
+        slot.generation++;
+        slot.nextFree = freeHead;
+        freeHead = slotIndex;
+    }
+
+    std::vector<T> values;
+    std::vector<uint32_t> denseToSlot;
+    std::vector<Slot> slots;
+    uint32_t freeHead = SlotHandle::INVALID_INDEX;
+};
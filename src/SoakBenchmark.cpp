@@ -0,0 +1,279 @@
+// Soak benchmark: plays N waves with a fixed seed and a scripted player, then
+// prints update/render frame-time percentiles, peak entity counts and heap
+// allocation counts as JSON. Links BrotatoSim and drives Game through
+// step()/applyInput(), so the numbers are comparable run to run.
+#include "Game.h"
+#include "JobSystem.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Every heap allocation in the process goes through here
+static std::atomic<unsigned long long> allocationCount{ 0 };
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+enum class InputMode {
+    AI,     // kite away from nearby enemies, drift back to the arena centre
+    CIRCLE, // run a fixed circle regardless of what is on screen
+    IDLE    // stand still
+};
+
+struct BenchmarkOptions {
+    int waves = 5;
+    uint64_t seed = 12345;
+    float spawnMultiplier = 1.0f;
+    int tickRate = 60;
+    int threads = -1;
+    bool render = false;
+    InputMode input = InputMode::AI;
+    const char* outPath = nullptr;
+};
+
+struct Percentiles {
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+Percentiles computePercentiles(std::vector<double>& samples) {
+    Percentiles result;
+    if (samples.empty()) return result;
+
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double p) {
+        size_t index = static_cast<size_t>(p * (samples.size() - 1) + 0.5);
+        return samples[std::min(index, samples.size() - 1)];
+    };
+    result.p50 = at(0.50);
+    result.p95 = at(0.95);
+    result.p99 = at(0.99);
+    result.max = samples.back();
+    return result;
+}
+
+const char* inputModeName(InputMode mode) {
+    switch (mode) {
+        case InputMode::CIRCLE: return "circle";
+        case InputMode::IDLE: return "idle";
+        default: return "ai";
+    }
+}
+
+// Weapons shoot where the player aims, so every mode aims at the nearest enemy
+GameInput scriptedInput(const Game& game, InputMode mode, const Vector2& arenaCenter, float time) {
+    const Player* player = game.getPlayer();
+    Vector2 playerPos = player->getPosition();
+
+    GameInput input;
+    input.move = Vector2(0, 0);
+    input.aimTarget = playerPos + Vector2(1, 0);
+
+    float nearestDistSq = -1.0f;
+    Vector2 away(0, 0);
+    for (const auto& enemy : game.getEnemies()) {
+        if (!enemy->isAlive()) continue;
+        Vector2 offset = playerPos - enemy->getPosition();
+        float distSq = offset.x * offset.x + offset.y * offset.y;
+        if (nearestDistSq < 0.0f || distSq < nearestDistSq) {
+            nearestDistSq = distSq;
+            input.aimTarget = enemy->getPosition();
+        }
+        // Inverse-square push from everything within 300px
+        if (distSq > 1.0f && distSq < 300.0f * 300.0f) {
+            away += offset * (1.0f / distSq);
+        }
+    }
+
+    switch (mode) {
+        case InputMode::AI: {
+            Vector2 toCenter = arenaCenter - playerPos;
+            Vector2 desired = away * 4000.0f + toCenter * 0.002f;
+            if (desired.length() > 0.1f) {
+                input.move = desired.normalized();
+            }
+            break;
+        }
+        case InputMode::CIRCLE: {
+            float angle = time * 1.5f;
+            input.move = Vector2(std::cos(angle), std::sin(angle));
+            break;
+        }
+        case InputMode::IDLE:
+            break;
+    }
+    return input;
+}
+
+bool parseArgs(int argc, char* args[], BenchmarkOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(args[i], "--waves") == 0 && hasValue) {
+            options.waves = std::max(1, std::atoi(args[++i]));
+        } else if (std::strcmp(args[i], "--seed") == 0 && hasValue) {
+            options.seed = std::strtoull(args[++i], nullptr, 10);
+        } else if (std::strcmp(args[i], "--spawn-multiplier") == 0 && hasValue) {
+            options.spawnMultiplier = static_cast<float>(std::atof(args[++i]));
+        } else if (std::strcmp(args[i], "--tickrate") == 0 && hasValue) {
+            options.tickRate = std::max(1, std::atoi(args[++i]));
+        } else if (std::strcmp(args[i], "--threads") == 0 && hasValue) {
+            options.threads = std::atoi(args[++i]);
+        } else if (std::strcmp(args[i], "--render") == 0) {
+            options.render = true;
+        } else if (std::strcmp(args[i], "--out") == 0 && hasValue) {
+            options.outPath = args[++i];
+        } else if (std::strcmp(args[i], "--input") == 0 && hasValue) {
+            const char* mode = args[++i];
+            if (std::strcmp(mode, "ai") == 0) options.input = InputMode::AI;
+            else if (std::strcmp(mode, "circle") == 0) options.input = InputMode::CIRCLE;
+            else if (std::strcmp(mode, "idle") == 0) options.input = InputMode::IDLE;
+            else return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void writePercentiles(std::ostream& out, const char* name, const Percentiles& p) {
+    out << "  \"" << name << "\": { \"p50\": " << p.p50 << ", \"p95\": " << p.p95
+        << ", \"p99\": " << p.p99 << ", \"max\": " << p.max << " },\n";
+}
+
+} // namespace
+
+int main(int argc, char* args[]) {
+    BenchmarkOptions options;
+    if (!parseArgs(argc, args, options)) {
+        std::cout << "Usage: BrotatoSoak [--waves N] [--seed N] [--spawn-multiplier X] [--tickrate N]"
+                  << " [--threads N] [--input ai|circle|idle] [--render] [--out file.json]" << std::endl;
+        return 1;
+    }
+
+    GameConfig config;
+    config.headless = !options.render;
+    config.fullscreen = false;
+    config.vsync = false;
+    config.softwareRenderer = true;
+    config.autoCloseShop = true;
+    config.tickRate = options.tickRate;
+    config.seed = options.seed;
+    config.spawnMultiplier = options.spawnMultiplier;
+    config.workerThreads = options.threads;
+
+    Game game;
+    if (!game.init(config)) {
+        std::cout << "Failed to initialize game!" << std::endl;
+        return 1;
+    }
+
+    const float fixedDeltaTime = 1.0f / options.tickRate;
+    const double msPerCounter = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    const Vector2 arenaCenter = game.getPlayer()->getPosition();
+
+    std::vector<double> updateMs;
+    std::vector<double> renderMs;
+    std::vector<double> tickAllocations;
+    EntityCounts peak = { 0, 0, 0, 0 };
+    unsigned long long runAllocations = 0; // inside game calls only, like the per-tick counts
+    long long ticks = 0;
+
+    while (game.isRunning() && game.getWave() <= options.waves) {
+        if (options.render) {
+            SDL_PumpEvents(); // keep the window responsive; input comes from the script
+        }
+        game.applyInput(scriptedInput(game, options.input, arenaCenter, ticks * fixedDeltaTime));
+
+        // Counters are read right around the game calls, so growing the
+        // benchmark's own sample vectors never counts as a game allocation
+        unsigned long long allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+        Uint64 start = SDL_GetPerformanceCounter();
+        game.step(fixedDeltaTime);
+        Uint64 end = SDL_GetPerformanceCounter();
+        unsigned long long allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+        updateMs.push_back((end - start) * msPerCounter);
+
+        if (options.render) {
+            allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            start = SDL_GetPerformanceCounter();
+            game.renderFrame(1.0f);
+            end = SDL_GetPerformanceCounter();
+            allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+            renderMs.push_back((end - start) * msPerCounter);
+        }
+        tickAllocations.push_back(static_cast<double>(allocations));
+        runAllocations += allocations;
+
+        EntityCounts counts = game.getEntityCounts();
+        peak.enemies = std::max(peak.enemies, counts.enemies);
+        peak.bullets = std::max(peak.bullets, counts.bullets);
+        peak.orbs = std::max(peak.orbs, counts.orbs);
+        peak.materials = std::max(peak.materials, counts.materials);
+
+        Profiler::instance().endFrame();
+        ticks++;
+    }
+
+    bool completed = game.getWave() > options.waves;
+    int wavesReached = std::min(game.getWave(), options.waves);
+
+    Percentiles update = computePercentiles(updateMs);
+    Percentiles render = computePercentiles(renderMs);
+    Percentiles allocations = computePercentiles(tickAllocations);
+
+    std::ostringstream json;
+    json << "{\n"
+         << "  \"seed\": " << options.seed << ",\n"
+         << "  \"waves\": " << options.waves << ",\n"
+         << "  \"wavesReached\": " << wavesReached << ",\n"
+         << "  \"completed\": " << (completed ? "true" : "false") << ",\n"
+         << "  \"input\": \"" << inputModeName(options.input) << "\",\n"
+         << "  \"spawnMultiplier\": " << options.spawnMultiplier << ",\n"
+         << "  \"workerThreads\": " << JobSystem::instance().getWorkerCount() << ",\n"
+         << "  \"render\": " << (options.render ? "true" : "false") << ",\n"
+         << "  \"ticks\": " << ticks << ",\n"
+         << "  \"simSeconds\": " << ticks * fixedDeltaTime << ",\n"
+         << "  \"score\": " << game.getScore() << ",\n";
+    writePercentiles(json, "updateMs", update);
+    if (options.render) {
+        writePercentiles(json, "renderMs", render);
+    }
+    json << "  \"peak\": { \"enemies\": " << peak.enemies << ", \"bullets\": " << peak.bullets
+         << ", \"orbs\": " << peak.orbs << ", \"materials\": " << peak.materials << " },\n"
+         << "  \"allocations\": { \"total\": " << runAllocations
+         << ", \"perTickP50\": " << allocations.p50
+         << ", \"perTickP99\": " << allocations.p99
+         << ", \"perTickMax\": " << allocations.max << " }\n"
+         << "}\n";
+
+    if (options.outPath) {
+        std::ofstream file(options.outPath);
+        file << json.str();
+    }
+    std::cout << json.str();
+
+    return completed ? 0 : 2;
+}
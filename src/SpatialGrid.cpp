@@ -0,0 +1,87 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(float worldWidth, float worldHeight, float cellSize)
+    : cellSize(cellSize), inverseCellSize(1.0f / cellSize),
+      cellsX(std::max(1, (int)(worldWidth / cellSize) + 1)),
+      cellsY(std::max(1, (int)(worldHeight / cellSize) + 1)) {
+    cellStart.assign(cellsX * cellsY + 1, 0);
+    cellCursor.assign(cellsX * cellsY, 0);
+}
+
+int SpatialGrid::clampCellX(float x) const {
+    int cx = (int)(x * inverseCellSize);
+    // Anything outside the arena is kept in the border cells
+    return std::min(std::max(cx, 0), cellsX - 1);
+}
+
+int SpatialGrid::clampCellY(float y) const {
+    int cy = (int)(y * inverseCellSize);
+    return std::min(std::max(cy, 0), cellsY - 1);
+}
+
+int SpatialGrid::cellIndex(float x, float y) const {
+    return clampCellY(y) * cellsX + clampCellX(x);
+}
+
+void SpatialGrid::clear() {
+    pendingIds.clear();
+    pendingCells.clear();
+    maxRadius = 0.0f;
+}
+
+void SpatialGrid::insert(int id, const Vector2& position, float radius) {
+    pendingIds.push_back(id);
+    pendingCells.push_back(cellIndex(position.x, position.y));
+    if (radius > maxRadius) {
+        maxRadius = radius;
+    }
+}
+
+void SpatialGrid::build() {
+    // Counting sort by cell: no per-cell vectors, no allocation once warmed up
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    for (int cell : pendingCells) {
+        cellStart[cell + 1]++;
+    }
+    for (size_t i = 1; i < cellStart.size(); ++i) {
+        cellStart[i] += cellStart[i - 1];
+    }
+
+    std::copy(cellStart.begin(), cellStart.end() - 1, cellCursor.begin());
+    cellItems.resize(pendingIds.size());
+    for (size_t i = 0; i < pendingIds.size(); ++i) {
+        cellItems[cellCursor[pendingCells[i]]++] = pendingIds[i];
+    }
+
+    stats.inserted = (int)pendingIds.size();
+}
+
+void SpatialGrid::query(const Vector2& position, float radius, std::vector<int>& out) {
+    out.clear();
+
+    // Entities are binned by center, so widen by the largest inserted radius
+    float reach = radius + maxRadius;
+    int minX = clampCellX(position.x - reach);
+    int maxX = clampCellX(position.x + reach);
+    int minY = clampCellY(position.y - reach);
+    int maxY = clampCellY(position.y + reach);
+
+    for (int cy = minY; cy <= maxY; ++cy) {
+        int rowStart = cy * cellsX;
+        // Cells in a row are contiguous in cellItems
+        int begin = cellStart[rowStart + minX];
+        int end = cellStart[rowStart + maxX + 1];
+        out.insert(out.end(), cellItems.begin() + begin, cellItems.begin() + end);
+    }
+
+    stats.queries++;
+    stats.candidates += (long long)out.size();
+    stats.maxCandidates = std::max(stats.maxCandidates, (int)out.size());
+}
+
+void SpatialGrid::resetStats() {
+    int inserted = stats.inserted;
+    stats = SpatialGridStats();
+    stats.inserted = inserted;
+}
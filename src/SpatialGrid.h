@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+#include "Vector2.h"
+
+struct SpatialGridStats {
+    int queries = 0;          // query() calls since the last resetStats()
+    long long candidates = 0; // ids handed back over all those queries
+    int maxCandidates = 0;    // largest single query result
+    int inserted = 0;         // ids in the grid as of the last build()
+};
+
+// Uniform grid broadphase over the arena. Each tick: clear(), insert() every
+// collider by its center, build(), then query() as often as needed. Ids are
+// whatever the caller indexes with (usually a position in an entity vector).
+// Results are candidates only - the caller still does the exact distance test.
+class SpatialGrid {
+public:
+    SpatialGrid(float worldWidth, float worldHeight, float cellSize);
+
+    void clear();
+    void insert(int id, const Vector2& position, float radius);
+    void build();
+
+    // Appends every id whose cell may overlap the circle; out is cleared first
+    void query(const Vector2& position, float radius, std::vector<int>& out);
+
+    const SpatialGridStats& getStats() const { return stats; }
+    void resetStats();
+
+private:
+    int cellIndex(float x, float y) const;
+    int clampCellX(float x) const;
+    int clampCellY(float y) const;
+
+    float cellSize;
+    float inverseCellSize;
+    int cellsX;
+    int cellsY;
+
+    // Pending inserts, laid out by build() into one array sorted by cell
+    std::vector<int> pendingIds;
+    std::vector<int> pendingCells;
+    float maxRadius = 0.0f;
+
+    std::vector<int> cellStart;  // cellsX * cellsY + 1 offsets into cellItems
+    std::vector<int> cellCursor;
+    std::vector<int> cellItems;
+
+    SpatialGridStats stats;
+};
@@ -6,7 +6,7 @@ public:
     SpeedUpBooster(const Vector2& spawnPosition);
     ~SpeedUpBooster();
 
-    void initialize(SDL_Renderer* renderer) override;
+    void initialize() override;
     void update(float deltaTime) override;
     void render(SDL_Renderer* renderer) override;
     void collect() override;
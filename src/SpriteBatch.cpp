@@ -0,0 +1,297 @@
+#include "SpriteBatch.h"
+#include "TextureCache.h"
+#include "Logger.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const int LAYER_SHIFT = 56;
+    const int RANK_SHIFT = 32;
+    const uint64_t RANK_MASK = 0xFFFFFF;
+
+    void rectCorners(float x, float y, float w, float h, SDL_FPoint corners[4]) {
+        corners[0] = { x, y };
+        corners[1] = { x + w, y };
+        corners[2] = { x + w, y + h };
+        corners[3] = { x, y + h };
+    }
+}
+
+SpriteBatch& SpriteBatch::instance() {
+    static SpriteBatch batch;
+    return batch;
+}
+
+void SpriteBatch::init(SDL_Renderer* sdlRenderer) {
+    renderer = sdlRenderer;
+
+    // Only used when the TextureCache has no atlas to borrow a white block from
+    Uint32 white = 0xFFFFFFFF;
+    whiteTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 1, 1);
+    if (!whiteTexture) {
+        LOG_ERROR(LogCategory::ASSETS, "Unable to create sprite batch texture! SDL Error: %s", SDL_GetError());
+        return;
+    }
+    SDL_UpdateTexture(whiteTexture, nullptr, &white, sizeof(white));
+    SDL_SetTextureBlendMode(whiteTexture, SDL_BLENDMODE_BLEND);
+}
+
+void SpriteBatch::clear() {
+    if (whiteTexture) {
+        SDL_DestroyTexture(whiteTexture);
+        whiteTexture = nullptr;
+    }
+    quads.clear();
+    for (auto& ranks : textureRank) {
+        ranks.clear();
+    }
+    batching = false;
+}
+
+void SpriteBatch::begin() {
+    batching = true;
+    currentLayer = 0;
+    quads.clear();
+}
+
+SDL_Texture* SpriteBatch::resolve(SDL_Texture* texture, const SDL_Rect* src, SDL_FRect& uv) const {
+    AtlasRegion region;
+    if (TextureCache::instance().findAtlasRegion(texture, region)) {
+        SDL_Rect area = region.rect;
+        if (src) {
+            area = { area.x + src->x, area.y + src->y, src->w, src->h };
+        }
+        uv = { area.x * region.inverseWidth, area.y * region.inverseHeight,
+               area.w * region.inverseWidth, area.h * region.inverseHeight };
+        return region.atlas;
+    }
+
+    if (!src) {
+        uv = { 0.0f, 0.0f, 1.0f, 1.0f };
+        return texture;
+    }
+    int width = 0;
+    int height = 0;
+    if (!TextureCache::instance().getSize(texture, width, height)) {
+        SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+    }
+    if (width <= 0 || height <= 0) {
+        uv = { 0.0f, 0.0f, 1.0f, 1.0f };
+        return texture;
+    }
+    uv = { (float)src->x / width, (float)src->y / height, (float)src->w / width, (float)src->h / height };
+    return texture;
+}
+
+void SpriteBatch::pushQuad(SDL_Texture* texture, const SDL_FRect& uv, const SDL_FPoint corners[4], SDL_Color color) {
+    if (!texture) return;
+
+    auto& ranks = textureRank[currentLayer];
+    auto rank = ranks.emplace(texture, (int)ranks.size()).first->second;
+
+    Quad quad;
+    quad.key = ((uint64_t)currentLayer << LAYER_SHIFT)
+             | (((uint64_t)rank & RANK_MASK) << RANK_SHIFT)
+             | (uint64_t)(uint32_t)quads.size();
+    quad.texture = texture;
+    const SDL_FPoint texCoords[4] = {
+        { uv.x, uv.y },
+        { uv.x + uv.w, uv.y },
+        { uv.x + uv.w, uv.y + uv.h },
+        { uv.x, uv.y + uv.h }
+    };
+    for (int i = 0; i < 4; ++i) {
+        quad.vertices[i].position = corners[i];
+        quad.vertices[i].color = color;
+        quad.vertices[i].tex_coord = texCoords[i];
+    }
+    quads.push_back(quad);
+}
+
+void SpriteBatch::fillQuad(const SDL_FPoint corners[4], SDL_Color color) {
+    AtlasRegion region;
+    if (TextureCache::instance().getWhiteRegion(region)) {
+        // Inner half of the block, so filtering never reaches the transparent padding
+        SDL_FRect uv = { (region.rect.x + 1) * region.inverseWidth, (region.rect.y + 1) * region.inverseHeight,
+                         (region.rect.w - 2) * region.inverseWidth, (region.rect.h - 2) * region.inverseHeight };
+        pushQuad(region.atlas, uv, corners, color);
+    } else {
+        pushQuad(whiteTexture, { 0.0f, 0.0f, 1.0f, 1.0f }, corners, color);
+    }
+}
+
+void SpriteBatch::copy(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect& dst, SDL_Color tint) {
+    if (!texture) return;
+
+    if (!batching) {
+        SDL_SetTextureColorMod(texture, tint.r, tint.g, tint.b);
+        SDL_SetTextureAlphaMod(texture, tint.a);
+        SDL_RenderCopy(renderer, texture, src, &dst);
+        return;
+    }
+
+    SDL_FRect uv;
+    SDL_Texture* drawn = resolve(texture, src, uv);
+    SDL_FPoint corners[4];
+    rectCorners((float)dst.x, (float)dst.y, (float)dst.w, (float)dst.h, corners);
+    pushQuad(drawn, uv, corners, tint);
+}
+
+void SpriteBatch::copyEx(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect& dst, double angleDegrees,
+                         SDL_RendererFlip flip, SDL_Color tint) {
+    if (!texture) return;
+
+    if (!batching) {
+        SDL_SetTextureColorMod(texture, tint.r, tint.g, tint.b);
+        SDL_SetTextureAlphaMod(texture, tint.a);
+        SDL_RenderCopyEx(renderer, texture, src, &dst, angleDegrees, nullptr, flip);
+        return;
+    }
+
+    SDL_FRect uv;
+    SDL_Texture* drawn = resolve(texture, src, uv);
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        uv.x += uv.w;
+        uv.w = -uv.w;
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+        uv.y += uv.h;
+        uv.h = -uv.h;
+    }
+
+    SDL_FPoint corners[4];
+    rectCorners((float)dst.x, (float)dst.y, (float)dst.w, (float)dst.h, corners);
+    if (angleDegrees != 0.0) {
+        // Clockwise around the center of dst, like SDL_RenderCopyEx with a null center
+        float radians = (float)(angleDegrees * M_PI / 180.0);
+        float c = std::cos(radians);
+        float s = std::sin(radians);
+        float centerX = dst.x + dst.w * 0.5f;
+        float centerY = dst.y + dst.h * 0.5f;
+        for (auto& corner : corners) {
+            float x = corner.x - centerX;
+            float y = corner.y - centerY;
+            corner = { centerX + x * c - y * s, centerY + x * s + y * c };
+        }
+    }
+    pushQuad(drawn, uv, corners, tint);
+}
+
+void SpriteBatch::fillRect(const SDL_Rect& rect, SDL_Color color) {
+    if (!batching) {
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderFillRect(renderer, &rect);
+        return;
+    }
+
+    SDL_FPoint corners[4];
+    rectCorners((float)rect.x, (float)rect.y, (float)rect.w, (float)rect.h, corners);
+    fillQuad(corners, color);
+}
+
+void SpriteBatch::drawRect(const SDL_Rect& rect, SDL_Color color) {
+    if (!batching) {
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderDrawRect(renderer, &rect);
+        return;
+    }
+    if (rect.w <= 0 || rect.h <= 0) return;
+
+    // Four one-pixel edges, the sides trimmed so the corners are not drawn twice
+    fillRect({ rect.x, rect.y, rect.w, 1 }, color);
+    if (rect.h > 1) {
+        fillRect({ rect.x, rect.y + rect.h - 1, rect.w, 1 }, color);
+    }
+    if (rect.h > 2) {
+        fillRect({ rect.x, rect.y + 1, 1, rect.h - 2 }, color);
+        if (rect.w > 1) {
+            fillRect({ rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2 }, color);
+        }
+    }
+}
+
+void SpriteBatch::drawLine(int x1, int y1, int x2, int y2, SDL_Color color) {
+    if (!batching) {
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
+        return;
+    }
+
+    float dx = (float)(x2 - x1);
+    float dy = (float)(y2 - y1);
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length < 0.5f) {
+        drawPoint(x1, y1, color);
+        return;
+    }
+
+    // A one-pixel-wide quad through the pixel centers, extended half a pixel
+    // past both ends so the end pixels are covered like SDL's line drawing
+    float ux = dx / length * 0.5f;
+    float uy = dy / length * 0.5f;
+    float startX = x1 + 0.5f - ux;
+    float startY = y1 + 0.5f - uy;
+    float endX = x2 + 0.5f + ux;
+    float endY = y2 + 0.5f + uy;
+    SDL_FPoint corners[4] = {
+        { startX - uy, startY + ux },
+        { endX - uy, endY + ux },
+        { endX + uy, endY - ux },
+        { startX + uy, startY - ux }
+    };
+    fillQuad(corners, color);
+}
+
+void SpriteBatch::drawPoint(int x, int y, SDL_Color color) {
+    if (!batching) {
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderDrawPoint(renderer, x, y);
+        return;
+    }
+
+    SDL_FPoint corners[4];
+    rectCorners((float)x, (float)y, 1.0f, 1.0f, corners);
+    fillQuad(corners, color);
+}
+
+void SpriteBatch::flush() {
+    PROFILE_SCOPE("SpriteBatch::flush");
+    batching = false;
+    lastQuadCount = (int)quads.size();
+    lastDrawCalls = 0;
+
+    order.resize(quads.size());
+    for (size_t i = 0; i < quads.size(); ++i) {
+        order[i] = (uint32_t)i;
+    }
+    // Keys are unique (the low bits are the submission index), so this is stable
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return quads[a].key < quads[b].key;
+    });
+
+    size_t runStart = 0;
+    while (runStart < order.size()) {
+        SDL_Texture* texture = quads[order[runStart]].texture;
+        size_t runEnd = runStart;
+        vertices.clear();
+        indices.clear();
+        while (runEnd < order.size() && quads[order[runEnd]].texture == texture) {
+            const Quad& quad = quads[order[runEnd]];
+            int base = (int)vertices.size();
+            vertices.insert(vertices.end(), quad.vertices, quad.vertices + 4);
+            const int quadIndices[6] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+            indices.insert(indices.end(), quadIndices, quadIndices + 6);
+            ++runEnd;
+        }
+
+        SDL_RenderGeometry(renderer, texture, vertices.data(), (int)vertices.size(), indices.data(), (int)indices.size());
+        lastDrawCalls++;
+        runStart = runEnd;
+    }
+
+    quads.clear();
+    for (auto& ranks : textureRank) {
+        ranks.clear();
+    }
+}
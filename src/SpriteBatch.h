@@ -0,0 +1,92 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Draw order of the world pass, back to front. Same order Game::render always
+// drew its sections in.
+enum class RenderLayer {
+    PLAYER,
+    WEAPONS,
+    BULLETS,
+    ENEMIES,
+    BOSS,
+    SPAWN_INDICATORS,
+    ORBS,
+    MATERIALS,
+    BOOSTERS
+};
+
+// Between begin() and flush() every sprite, primitive and shape is queued as a
+// textured quad instead of drawn. flush() sorts the quads by layer, then by
+// texture (in the order each texture was first used on that layer, so a
+// muzzle flash still lands on top of its gun), then by submission order, and
+// hands each run of one texture to SDL_RenderGeometry. Sprites from the
+// TextureCache atlas and untextured shapes (the atlas' white block) share a
+// texture, so a screen of enemies with health bars is a handful of draw calls.
+// Outside begin()/flush() every call draws immediately, which the UI and shop
+// rely on for text ordering.
+class SpriteBatch {
+public:
+    static SpriteBatch& instance();
+
+    void init(SDL_Renderer* renderer);
+    void clear();
+
+    void begin();
+    void setLayer(RenderLayer layer) { currentLayer = static_cast<int>(layer); }
+    void flush();
+
+    // Lets calls draw immediately in the middle of a batched pass, e.g. into a
+    // render target; the queued quads are kept. Returns the state for resume().
+    bool pause() { bool wasBatching = batching; batching = false; return wasBatching; }
+    void resume(bool wasBatching) { batching = wasBatching; }
+
+    // SDL_RenderCopy / SDL_RenderCopyEx, tinted like SDL_SetTextureColorMod + AlphaMod
+    void copy(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect& dst, SDL_Color tint = { 255, 255, 255, 255 });
+    void copyEx(SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect& dst, double angleDegrees,
+                SDL_RendererFlip flip, SDL_Color tint = { 255, 255, 255, 255 });
+
+    // SDL_RenderFillRect / DrawRect / DrawLine / DrawPoint with an explicit color
+    void fillRect(const SDL_Rect& rect, SDL_Color color);
+    void drawRect(const SDL_Rect& rect, SDL_Color color);
+    void drawLine(int x1, int y1, int x2, int y2, SDL_Color color);
+    void drawPoint(int x, int y, SDL_Color color);
+
+    // Last flush(), for the profiler overlay
+    int getLastQuadCount() const { return lastQuadCount; }
+    int getLastDrawCalls() const { return lastDrawCalls; }
+
+private:
+    SpriteBatch() = default;
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    struct Quad {
+        uint64_t key; // layer | texture rank | sequence
+        SDL_Texture* texture;
+        SDL_Vertex vertices[4];
+    };
+
+    // Corners in screen space, UVs from the region of `texture` that src maps to
+    void pushQuad(SDL_Texture* texture, const SDL_FRect& uv, const SDL_FPoint corners[4], SDL_Color color);
+    // Resolves a texture (and optional source rect) to the texture actually
+    // drawn - the atlas if it was packed - and normalized UVs
+    SDL_Texture* resolve(SDL_Texture* texture, const SDL_Rect* src, SDL_FRect& uv) const;
+    void fillQuad(const SDL_FPoint corners[4], SDL_Color color);
+
+    SDL_Renderer* renderer = nullptr;
+    SDL_Texture* whiteTexture = nullptr; // fallback when there is no atlas
+    bool batching = false;
+    int currentLayer = 0;
+
+    std::vector<Quad> quads;
+    std::vector<uint32_t> order;            // quad indices sorted by key
+    std::unordered_map<SDL_Texture*, int> textureRank[static_cast<int>(RenderLayer::BOOSTERS) + 1];
+    std::vector<SDL_Vertex> vertices;       // one run, handed to SDL_RenderGeometry
+    std::vector<int> indices;
+
+    int lastQuadCount = 0;
+    int lastDrawCalls = 0;
+};
@@ -0,0 +1,220 @@
+#include "TextRenderer.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // Characters that make up counters, timers and "current / max" readouts
+    const char NUMERIC_GLYPHS[] = "0123456789 /:.-+%";
+}
+
+TextRenderer::~TextRenderer() {
+    clear();
+}
+
+bool TextRenderer::init(SDL_Renderer* sdlRenderer, const std::vector<const char*>& fontPaths) {
+    renderer = sdlRenderer;
+
+    for (const char* path : fontPaths) {
+        TTF_Font* font = TTF_OpenFont(path, 16);
+        if (font) {
+            LOG_INFO(LogCategory::ASSETS, "Loaded font: %s", path);
+            fontPath = path;
+            fonts[16] = font;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TextRenderer::clear() {
+    for (auto& pair : labels) {
+        SDL_DestroyTexture(pair.second.texture);
+    }
+    labels.clear();
+    lru.clear();
+
+    for (auto& pair : glyphAtlases) {
+        if (pair.second->texture) {
+            SDL_DestroyTexture(pair.second->texture);
+        }
+    }
+    glyphAtlases.clear();
+
+    for (auto& pair : fonts) {
+        if (pair.second) {
+            TTF_CloseFont(pair.second);
+        }
+    }
+    fonts.clear();
+}
+
+TTF_Font* TextRenderer::getFont(int fontSize) {
+    auto it = fonts.find(fontSize);
+    if (it != fonts.end()) {
+        return it->second;
+    }
+
+    TTF_Font* font = TTF_OpenFont(fontPath.c_str(), fontSize);
+    if (!font) {
+        LOG_WARN(LogCategory::ASSETS, "Unable to open font %s at size %d! SDL_ttf Error: %s", fontPath.c_str(), fontSize, TTF_GetError());
+    }
+    // Cache failures too so a bad size is not retried every frame
+    fonts[fontSize] = font;
+    return font;
+}
+
+bool TextRenderer::isNumeric(const char* text) {
+    if (!*text) return false;
+    for (const char* c = text; *c; ++c) {
+        if (!std::strchr(NUMERIC_GLYPHS, *c)) return false;
+    }
+    return true;
+}
+
+void TextRenderer::draw(const char* text, int x, int y, SDL_Color color, int fontSize) {
+    if (!isAvailable() || !text || !*text) return;
+
+    if (isNumeric(text)) {
+        drawGlyphs(text, x, y, color, fontSize);
+    } else {
+        drawLabel(text, x, y, color, fontSize);
+    }
+}
+
+void TextRenderer::drawLabel(const char* text, int x, int y, SDL_Color color, int fontSize) {
+    LabelKey key{ text, fontSize, ((Uint32)color.r << 24) | ((Uint32)color.g << 16) | ((Uint32)color.b << 8) | color.a };
+
+    auto it = labels.find(key);
+    if (it != labels.end()) {
+        stats.hits++;
+        lru.splice(lru.begin(), lru, it->second.lruPosition);
+        SDL_Rect destRect = { x, y, it->second.width, it->second.height };
+        SDL_RenderCopy(renderer, it->second.texture, nullptr, &destRect);
+        return;
+    }
+
+    TTF_Font* font = getFont(fontSize);
+    if (!font) return;
+
+    stats.misses++;
+    SDL_Surface* textSurface = TTF_RenderText_Blended(font, text, color);
+    if (!textSurface) {
+        LOG_WARN(LogCategory::ASSETS, "Unable to render text surface! SDL_ttf Error: %s", TTF_GetError());
+        return;
+    }
+
+    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
+    Label label;
+    label.width = textSurface->w;
+    label.height = textSurface->h;
+    SDL_FreeSurface(textSurface);
+
+    if (!textTexture) {
+        LOG_WARN(LogCategory::ASSETS, "Unable to create texture from text! SDL Error: %s", SDL_GetError());
+        return;
+    }
+    label.texture = textTexture;
+
+    if (labels.size() >= MAX_CACHED_LABELS) {
+        auto oldest = labels.find(lru.back());
+        SDL_DestroyTexture(oldest->second.texture);
+        labels.erase(oldest);
+        lru.pop_back();
+        stats.evictions++;
+    }
+
+    lru.push_front(key);
+    label.lruPosition = lru.begin();
+    labels.emplace(std::move(key), label);
+
+    SDL_Rect destRect = { x, y, label.width, label.height };
+    SDL_RenderCopy(renderer, textTexture, nullptr, &destRect);
+}
+
+TextRenderer::GlyphAtlas* TextRenderer::getGlyphAtlas(int fontSize) {
+    auto it = glyphAtlases.find(fontSize);
+    if (it != glyphAtlases.end()) {
+        return it->second.get();
+    }
+
+    auto atlas = std::make_unique<GlyphAtlas>();
+    TTF_Font* font = getFont(fontSize);
+    if (font) {
+        // Rasterise each glyph in white and pack them left to right in one row
+        const SDL_Color white = { 255, 255, 255, 255 };
+        std::vector<SDL_Surface*> glyphSurfaces;
+        int atlasWidth = 0;
+        int atlasHeight = 0;
+        for (const char* c = NUMERIC_GLYPHS; *c; ++c) {
+            int minX, maxX, minY, maxY, advance;
+            TTF_GlyphMetrics(font, (Uint16)*c, &minX, &maxX, &minY, &maxY, &advance);
+            atlas->advances[(int)*c] = advance;
+
+            SDL_Surface* glyph = TTF_RenderGlyph_Blended(font, (Uint16)*c, white);
+            glyphSurfaces.push_back(glyph);
+            if (glyph) {
+                atlas->glyphRects[(int)*c] = { atlasWidth, 0, glyph->w, glyph->h };
+                atlasWidth += glyph->w;
+                atlasHeight = std::max(atlasHeight, glyph->h);
+            }
+        }
+
+        SDL_Surface* atlasSurface = nullptr;
+        if (atlasWidth > 0 && atlasHeight > 0) {
+            atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+        }
+        for (size_t i = 0; i < glyphSurfaces.size(); ++i) {
+            SDL_Surface* glyph = glyphSurfaces[i];
+            if (!glyph) continue;
+            if (atlasSurface) {
+                // Copy alpha as-is instead of blending onto the empty atlas
+                SDL_SetSurfaceBlendMode(glyph, SDL_BLENDMODE_NONE);
+                SDL_Rect dst = atlas->glyphRects[(int)NUMERIC_GLYPHS[i]];
+                SDL_BlitSurface(glyph, nullptr, atlasSurface, &dst);
+            }
+            SDL_FreeSurface(glyph);
+        }
+
+        if (atlasSurface) {
+            atlas->texture = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+            SDL_FreeSurface(atlasSurface);
+            if (atlas->texture) {
+                SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+            }
+        }
+    }
+
+    GlyphAtlas* result = atlas.get();
+    glyphAtlases[fontSize] = std::move(atlas);
+    return result;
+}
+
+void TextRenderer::drawGlyphs(const char* text, int x, int y, SDL_Color color, int fontSize) {
+    GlyphAtlas* atlas = getGlyphAtlas(fontSize);
+    if (!atlas->texture) {
+        // No atlas for this size - let the label cache handle it
+        drawLabel(text, x, y, color, fontSize);
+        return;
+    }
+
+    stats.glyphDraws++;
+    SDL_SetTextureColorMod(atlas->texture, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(atlas->texture, color.a);
+
+    int penX = x;
+    for (const char* c = text; *c; ++c) {
+        const SDL_Rect& src = atlas->glyphRects[(int)*c];
+        if (src.w > 0) {
+            SDL_Rect dst = { penX, y, src.w, src.h };
+            SDL_RenderCopy(renderer, atlas->texture, &src, &dst);
+        }
+        penX += atlas->advances[(int)*c];
+    }
+}
+
+void TextRenderer::logStats() const {
+    LOG_INFO(LogCategory::ASSETS, "TextRenderer: %d labels cached, %d font sizes, %d hits, %d misses, %d evictions, %d glyph draws",
+             static_cast<int>(labels.size()), static_cast<int>(fonts.size()),
+             stats.hits, stats.misses, stats.evictions, stats.glyphDraws);
+}
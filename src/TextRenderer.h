@@ -0,0 +1,85 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct TextCacheStats {
+    int hits = 0;       // labels drawn from an existing texture
+    int misses = 0;     // labels rasterised and uploaded
+    int evictions = 0;  // least recently used labels dropped to stay under capacity
+    int glyphDraws = 0; // numeric strings drawn from a glyph atlas instead
+};
+
+// TTF text drawing for Game and Shop. Fonts are opened once per requested
+// point size. Static labels are rasterised once and kept in an LRU cache keyed
+// on (text, size, color); purely numeric strings (timer, HP, prices) are drawn
+// glyph by glyph from a per-size atlas so changing values never upload anything.
+class TextRenderer {
+public:
+    TextRenderer() = default;
+    ~TextRenderer();
+
+    // Picks the first font file that opens; returns false if none do
+    bool init(SDL_Renderer* renderer, const std::vector<const char*>& fontPaths);
+    void clear();
+
+    bool isAvailable() const { return !fontPath.empty(); }
+    void draw(const char* text, int x, int y, SDL_Color color, int fontSize);
+
+    const TextCacheStats& getStats() const { return stats; }
+    void logStats() const;
+
+    static const size_t MAX_CACHED_LABELS = 256;
+
+private:
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    struct LabelKey {
+        std::string text;
+        int size;
+        Uint32 rgba;
+        bool operator==(const LabelKey& other) const {
+            return size == other.size && rgba == other.rgba && text == other.text;
+        }
+    };
+    struct LabelKeyHash {
+        size_t operator()(const LabelKey& key) const {
+            return std::hash<std::string>()(key.text) ^ ((size_t)key.rgba * 31u + (size_t)key.size);
+        }
+    };
+    struct Label {
+        SDL_Texture* texture = nullptr;
+        int width = 0;
+        int height = 0;
+        std::list<LabelKey>::iterator lruPosition;
+    };
+
+    // White glyphs packed in one texture and tinted with SDL_SetTextureColorMod
+    struct GlyphAtlas {
+        SDL_Texture* texture = nullptr;
+        SDL_Rect glyphRects[128] = {};
+        int advances[128] = {};
+    };
+
+    TTF_Font* getFont(int fontSize);
+    GlyphAtlas* getGlyphAtlas(int fontSize);
+    static bool isNumeric(const char* text);
+    void drawGlyphs(const char* text, int x, int y, SDL_Color color, int fontSize);
+    void drawLabel(const char* text, int x, int y, SDL_Color color, int fontSize);
+
+    SDL_Renderer* renderer = nullptr;
+    std::string fontPath;
+    std::map<int, TTF_Font*> fonts;
+    std::map<int, std::unique_ptr<GlyphAtlas>> glyphAtlases;
+
+    std::unordered_map<LabelKey, Label, LabelKeyHash> labels;
+    std::list<LabelKey> lru; // front = most recently drawn
+
+    TextCacheStats stats;
+};
@@ -0,0 +1,256 @@
+#include "TextureCache.h"
+#include <SDL2/SDL_image.h>
+#include "Logger.h"
+#include <algorithm>
+
+namespace {
+    const int MAX_ATLAS_SIZE = 2048;
+    const int ATLAS_PADDING = 2;   // transparent gap so linear filtering does not bleed neighbours in
+    const int WHITE_BLOCK_SIZE = 4; // UVs sample its inner 2x2, never its edge
+}
+
+TextureCache& TextureCache::instance() {
+    static TextureCache cache;
+    return cache;
+}
+
+void TextureCache::init(SDL_Renderer* sdlRenderer) {
+    renderer = sdlRenderer;
+}
+
+void TextureCache::preload(const std::vector<std::string>& paths) {
+    if (!renderer) return;
+
+    std::vector<std::pair<SDL_Texture*, SDL_Surface*>> sprites;
+    for (const auto& path : paths) {
+        if (entries.find(path) != entries.end()) continue;
+        SDL_Surface* surface = nullptr;
+        Entry& entry = load(path, &surface);
+        stats.preloaded++;
+        if (entry.texture && surface) {
+            sprites.emplace_back(entry.texture, surface);
+        } else if (surface) {
+            SDL_FreeSurface(surface);
+        }
+    }
+
+    buildAtlas(sprites);
+    for (auto& sprite : sprites) {
+        SDL_FreeSurface(sprite.second);
+    }
+}
+
+void TextureCache::buildAtlas(const std::vector<std::pair<SDL_Texture*, SDL_Surface*>>& sprites) {
+    if (atlas || sprites.empty()) return;
+
+    SDL_RendererInfo info;
+    int maxWidth = MAX_ATLAS_SIZE;
+    int maxHeight = MAX_ATLAS_SIZE;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0) {
+        maxWidth = std::min(maxWidth, info.max_texture_width);
+        maxHeight = std::min(maxHeight, info.max_texture_height);
+    }
+
+    // Shelf packing, tallest first. The white block takes the first slot.
+    std::vector<int> byHeight(sprites.size());
+    for (size_t i = 0; i < sprites.size(); ++i) byHeight[i] = (int)i;
+    std::sort(byHeight.begin(), byHeight.end(), [&](int a, int b) {
+        return sprites[a].second->h > sprites[b].second->h;
+    });
+
+    std::vector<SDL_Rect> placed(sprites.size(), SDL_Rect{ 0, 0, 0, 0 });
+    whiteRect = { ATLAS_PADDING, ATLAS_PADDING, WHITE_BLOCK_SIZE, WHITE_BLOCK_SIZE };
+    int shelfX = whiteRect.x + WHITE_BLOCK_SIZE + ATLAS_PADDING;
+    int shelfY = ATLAS_PADDING;
+    int shelfHeight = WHITE_BLOCK_SIZE;
+    int usedWidth = shelfX;
+    int usedHeight = shelfY + shelfHeight;
+    for (int i : byHeight) {
+        const SDL_Surface* surface = sprites[i].second;
+        if (surface->w + 2 * ATLAS_PADDING > maxWidth) continue;
+        if (shelfX + surface->w + ATLAS_PADDING > maxWidth) {
+            shelfY += shelfHeight + ATLAS_PADDING;
+            shelfX = ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+        if (shelfY + surface->h + ATLAS_PADDING > maxHeight) continue; // stays a standalone texture
+        placed[i] = { shelfX, shelfY, surface->w, surface->h };
+        shelfX += surface->w + ATLAS_PADDING;
+        shelfHeight = std::max(shelfHeight, surface->h);
+        usedWidth = std::max(usedWidth, shelfX);
+        usedHeight = std::max(usedHeight, shelfY + shelfHeight + ATLAS_PADDING);
+    }
+
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, usedWidth, usedHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!sheet) {
+        LOG_ERROR(LogCategory::ASSETS, "Unable to create sprite atlas surface! SDL Error: %s", SDL_GetError());
+        return;
+    }
+    SDL_FillRect(sheet, nullptr, SDL_MapRGBA(sheet->format, 0, 0, 0, 0));
+    SDL_FillRect(sheet, &whiteRect, SDL_MapRGBA(sheet->format, 255, 255, 255, 255));
+
+    int packed = 0;
+    for (size_t i = 0; i < sprites.size(); ++i) {
+        if (placed[i].w == 0) continue;
+        // Copy pixels and alpha as they are instead of blending onto the empty sheet
+        SDL_Surface* source = sprites[i].second;
+        SDL_BlendMode previousMode;
+        SDL_GetSurfaceBlendMode(source, &previousMode);
+        SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+        SDL_Rect target = placed[i];
+        if (SDL_BlitSurface(source, nullptr, sheet, &target) == 0) {
+            atlasRects[sprites[i].first] = placed[i];
+            packed++;
+        }
+        SDL_SetSurfaceBlendMode(source, previousMode);
+    }
+
+    atlas = SDL_CreateTextureFromSurface(renderer, sheet);
+    SDL_FreeSurface(sheet);
+    if (!atlas) {
+        LOG_ERROR(LogCategory::ASSETS, "Unable to create sprite atlas texture! SDL Error: %s", SDL_GetError());
+        atlasRects.clear();
+        return;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+    atlasWidth = usedWidth;
+    atlasHeight = usedHeight;
+    stats.atlasSprites = packed;
+    LOG_INFO(LogCategory::ASSETS, "Sprite atlas: %d of %d sprites in %dx%d",
+             packed, (int)sprites.size(), atlasWidth, atlasHeight);
+}
+
+AtlasRegion TextureCache::regionFor(const SDL_Rect& rect) const {
+    AtlasRegion region;
+    region.atlas = atlas;
+    region.rect = rect;
+    region.inverseWidth = 1.0f / atlasWidth;
+    region.inverseHeight = 1.0f / atlasHeight;
+    return region;
+}
+
+bool TextureCache::findAtlasRegion(SDL_Texture* texture, AtlasRegion& region) const {
+    auto it = atlasRects.find(texture);
+    if (it == atlasRects.end()) return false;
+    region = regionFor(it->second);
+    return true;
+}
+
+bool TextureCache::getWhiteRegion(AtlasRegion& region) const {
+    if (!atlas) return false;
+    region = regionFor(whiteRect);
+    return true;
+}
+
+TextureCache::Entry& TextureCache::load(const std::string& path, SDL_Surface** keepSurface) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    Entry entry;
+
+    SDL_Surface* surface = IMG_Load(path.c_str());
+    if (!surface) {
+        LOG_ERROR(LogCategory::ASSETS, "Unable to load image %s! SDL_image Error: %s", path.c_str(), IMG_GetError());
+    } else {
+        entry.texture = SDL_CreateTextureFromSurface(renderer, surface);
+        entry.width = surface->w;
+        entry.height = surface->h;
+        if (keepSurface) {
+            *keepSurface = surface;
+        } else {
+            SDL_FreeSurface(surface);
+        }
+
+        if (!entry.texture) {
+            LOG_ERROR(LogCategory::ASSETS, "Unable to create texture from %s! SDL Error: %s", path.c_str(), SDL_GetError());
+        }
+    }
+
+    if (!entry.texture) {
+        // Remember the failure so a missing file is not retried on every spawn
+        stats.failedLoads++;
+    } else {
+        pathByTexture[entry.texture] = path;
+    }
+
+    stats.loadTimeMs += (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    return entries[path] = entry;
+}
+
+SDL_Texture* TextureCache::acquire(const std::string& path) {
+    if (!renderer) return nullptr;
+
+    auto it = entries.find(path);
+    if (it != entries.end()) {
+        stats.hits++;
+        it->second.refCount++;
+        return it->second.texture;
+    }
+
+    stats.misses++;
+    Entry& entry = load(path);
+    entry.refCount++;
+    return entry.texture;
+}
+
+void TextureCache::release(SDL_Texture* texture) {
+    if (!texture) return;
+
+    auto it = pathByTexture.find(texture);
+    if (it == pathByTexture.end()) return;
+
+    Entry& entry = entries[it->second];
+    if (entry.refCount > 0) {
+        entry.refCount--;
+    }
+    // Unreferenced textures stay resident so the next spawn is still a hit
+}
+
+bool TextureCache::getSize(SDL_Texture* texture, int& width, int& height) const {
+    auto it = pathByTexture.find(texture);
+    if (it == pathByTexture.end()) return false;
+
+    const Entry& entry = entries.at(it->second);
+    width = entry.width;
+    height = entry.height;
+    return true;
+}
+
+void TextureCache::purgeUnused() {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.refCount == 0) {
+            if (it->second.texture) {
+                pathByTexture.erase(it->second.texture);
+                atlasRects.erase(it->second.texture);
+                SDL_DestroyTexture(it->second.texture);
+            }
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TextureCache::clear() {
+    for (auto& pair : entries) {
+        if (pair.second.texture) {
+            SDL_DestroyTexture(pair.second.texture);
+        }
+    }
+    entries.clear();
+    pathByTexture.clear();
+
+    if (atlas) {
+        SDL_DestroyTexture(atlas);
+        atlas = nullptr;
+    }
+    atlasRects.clear();
+    stats.atlasSprites = 0;
+}
+
+int TextureCache::getResidentCount() const {
+    return static_cast<int>(pathByTexture.size());
+}
+
+void TextureCache::logStats() const {
+    LOG_INFO(LogCategory::ASSETS, "TextureCache: %d textures resident, %d preloaded (%d in atlas), %d hits, %d misses, %d failed, %.1f ms loading",
+             getResidentCount(), stats.preloaded, stats.atlasSprites, stats.hits, stats.misses, stats.failedLoads, stats.loadTimeMs);
+}
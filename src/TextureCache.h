@@ -0,0 +1,86 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct TextureCacheStats {
+    int hits = 0;            // acquire() served from memory
+    int misses = 0;          // acquire() that had to decode a PNG
+    int preloaded = 0;       // textures decoded up front by preload()
+    int failedLoads = 0;     // paths that could not be loaded (cached as nullptr)
+    double loadTimeMs = 0.0; // total time spent in IMG_Load + GPU upload
+    int atlasSprites = 0;    // preloaded images packed into the sprite atlas
+};
+
+// Where a texture's pixels sit inside the sprite atlas
+struct AtlasRegion {
+    SDL_Texture* atlas = nullptr;
+    SDL_Rect rect = { 0, 0, 0, 0 };
+    float inverseWidth = 0.0f;  // 1 / atlas size, to turn rect into UVs
+    float inverseHeight = 0.0f;
+};
+
+// Shared texture store. Every image is decoded and uploaded once (normally from
+// Game::init through preload()) and handed out as a plain SDL_Texture*.
+// Entities acquire() in their constructor and release() in their destructor
+// instead of owning and destroying their own copy, so spawning costs no file I/O.
+// preload() also packs everything it loads, plus a white block for untextured
+// shapes, into one atlas texture that SpriteBatch draws from; the individual
+// textures stay valid for code that draws immediately.
+class TextureCache {
+public:
+    static TextureCache& instance();
+
+    void init(SDL_Renderer* renderer);
+    void preload(const std::vector<std::string>& paths);
+
+    // Returns nullptr if the image is missing or there is no renderer (headless)
+    SDL_Texture* acquire(const std::string& path);
+    void release(SDL_Texture* texture);
+
+    // Size of a cached texture without a round trip through SDL_QueryTexture
+    bool getSize(SDL_Texture* texture, int& width, int& height) const;
+
+    // False if the texture was not packed (loaded after preload, or did not fit)
+    bool findAtlasRegion(SDL_Texture* texture, AtlasRegion& region) const;
+    // Opaque white pixels inside the atlas; false if there is no atlas
+    bool getWhiteRegion(AtlasRegion& region) const;
+
+    // Drops textures nobody references any more; clear() drops everything
+    void purgeUnused();
+    void clear();
+
+    const TextureCacheStats& getStats() const { return stats; }
+    int getResidentCount() const;
+    void logStats() const;
+
+private:
+    TextureCache() = default;
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    struct Entry {
+        SDL_Texture* texture = nullptr;
+        int refCount = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    // keepSurface receives the decoded image (caller frees) instead of it being freed here
+    Entry& load(const std::string& path, SDL_Surface** keepSurface = nullptr);
+    void buildAtlas(const std::vector<std::pair<SDL_Texture*, SDL_Surface*>>& sprites);
+    AtlasRegion regionFor(const SDL_Rect& rect) const;
+
+    SDL_Renderer* renderer = nullptr;
+    std::unordered_map<std::string, Entry> entries;
+    std::unordered_map<SDL_Texture*, std::string> pathByTexture;
+    TextureCacheStats stats;
+
+    SDL_Texture* atlas = nullptr;
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+    SDL_Rect whiteRect = { 0, 0, 0, 0 };
+    std::unordered_map<SDL_Texture*, SDL_Rect> atlasRects;
+};
@@ -31,4 +31,8 @@ Vector2 Vector2::normalized() const {
 
 float Vector2::distance(const Vector2& other) const {
     return (*this - other).length();
+}
+
+Vector2 Vector2::lerp(const Vector2& a, const Vector2& b, float t) {
+    return Vector2(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
 }
\ No newline at end of file
@@ -14,4 +14,6 @@ struct Vector2 {
     float length() const;
     Vector2 normalized() const;
     float distance(const Vector2& other) const;
+    
+    static Vector2 lerp(const Vector2& a, const Vector2& b, float t);
 };
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "Weapon.h"
 #include "Enemy.h"
 #include "Player.h"
+#include "TextureCache.h"
+#include "PrimitiveCache.h"
+#include "SpriteBatch.h"
+#include "Random.h"
 #include <cmath>
 #include <algorithm>
-#include <random>
-#include <SDL2/SDL_image.h>
 #include <iostream>
 
 Weapon::Weapon(WeaponType weaponType, WeaponTier weaponTier) 
@@ -35,17 +37,14 @@ Weapon::Weapon(WeaponType weaponType, WeaponTier weaponTier)
 }
 
 Weapon::~Weapon() {
-    if (weaponTexture) {
-        SDL_DestroyTexture(weaponTexture);
-        weaponTexture = nullptr;
-    }
+    TextureCache::instance().release(weaponTexture);
 }
 
-void Weapon::initialize(SDL_Renderer* renderer) {
-    loadWeaponTexture(renderer);
+void Weapon::initialize() {
+    loadWeaponTexture();
 }
 
-void Weapon::loadWeaponTexture(SDL_Renderer* renderer) {
+void Weapon::loadWeaponTexture() {
     std::string texturePath;
     
     switch (type) {
@@ -84,18 +83,10 @@ void Weapon::loadWeaponTexture(SDL_Renderer* renderer) {
             break;
     }
     
-    SDL_Surface* surface = IMG_Load(texturePath.c_str());
-    if (!surface) {
-        std::cout << "Failed to load weapon texture: " << texturePath << " - " << IMG_GetError() << std::endl;
-        return;
-    }
-    
-    weaponTexture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
-    
-    if (!weaponTexture) {
-        std::cout << "Failed to create weapon texture: " << SDL_GetError() << std::endl;
-    }
+    // Re-initialising swaps the reference rather than leaking the old one
+    TextureCache& cache = TextureCache::instance();
+    cache.release(weaponTexture);
+    weaponTexture = cache.acquire(texturePath);
 }
 
 void Weapon::initializePistolStats() {
@@ -247,7 +238,7 @@ void Weapon::initializeSniperStats() {
 
 void Weapon::update(float deltaTime, const Vector2& weaponPos, 
                    const Vector2& aimDirection,
-                   std::vector<std::unique_ptr<Bullet>>& bullets,
+                   BulletPool& bullets,
                    const Player& player) {
     timeSinceLastShot += deltaTime;
     muzzleFlashTimer = std::max(0.0f, muzzleFlashTimer - deltaTime);
@@ -277,10 +268,9 @@ void Weapon::render(SDL_Renderer* renderer, const Vector2& weaponPos, const Vect
     if (type == WeaponType::ORBITING_BRICK) {
         // Рисуем небольшой кирпич по орбите (как квадрат)
         Vector2 pos = weaponPos; // фактическая позиция уже передана как орбитальная
-        SDL_SetRenderDrawColor(renderer, 160, 82, 45, 255);
         int s = (int)orbitHitRadius; // размер квадрата
         SDL_Rect r{(int)(pos.x - s/2), (int)(pos.y - s/2), s, s};
-        SDL_RenderFillRect(renderer, &r);
+        SpriteBatch::instance().fillRect(r, {160, 82, 45, 255});
         return;
     }
     // Special rendering for melee weapons
@@ -290,7 +280,8 @@ void Weapon::render(SDL_Renderer* renderer, const Vector2& weaponPos, const Vect
             Vector2 weaponTip = getWeaponTipPosition(weaponPos, weaponDirection);
             
             // Draw the weapon as a thick line from player to current tip position
-            SDL_SetRenderDrawColor(renderer, 139, 69, 19, 255); // Brown color for stick
+            SpriteBatch& batch = SpriteBatch::instance();
+            SDL_Color stickColor = {139, 69, 19, 255}; // Brown color for stick
             
             // Draw multiple lines to make it thicker
             for (int offset = -2; offset <= 2; offset++) {
@@ -298,13 +289,11 @@ void Weapon::render(SDL_Renderer* renderer, const Vector2& weaponPos, const Vect
                 Vector2 startPos = weaponPos + perpendicular * offset;
                 Vector2 endPos = weaponTip + perpendicular * offset;
                 
-                SDL_RenderDrawLine(renderer, 
-                                  (int)startPos.x, (int)startPos.y,
-                                  (int)endPos.x, (int)endPos.y);
+                batch.drawLine((int)startPos.x, (int)startPos.y,
+                               (int)endPos.x, (int)endPos.y, stickColor);
             }
             
             // Draw the brick at the tip
-            SDL_SetRenderDrawColor(renderer, 160, 82, 45, 255); // Darker brown for brick
             int brickSize = 6;
             SDL_Rect brickRect = {
                 (int)weaponTip.x - brickSize/2,
@@ -312,7 +301,7 @@ void Weapon::render(SDL_Renderer* renderer, const Vector2& weaponPos, const Vect
                 brickSize,
                 brickSize
             };
-            SDL_RenderFillRect(renderer, &brickRect);
+            batch.fillRect(brickRect, {160, 82, 45, 255}); // Darker brown for brick
         }
         
         // Don't render the normal weapon texture for melee weapons during attack
@@ -323,17 +312,15 @@ void Weapon::render(SDL_Renderer* renderer, const Vector2& weaponPos, const Vect
     
     if (!weaponTexture) {
         // Fallback to line rendering if no texture
-        SDL_SetRenderDrawColor(renderer, 150, 150, 150, 255);
         Vector2 weaponEnd = weaponPos + weaponDirection * 15;
-        SDL_RenderDrawLine(renderer, 
-                          (int)weaponPos.x, (int)weaponPos.y,
-                          (int)weaponEnd.x, (int)weaponEnd.y);
+        SpriteBatch::instance().drawLine((int)weaponPos.x, (int)weaponPos.y,
+                                         (int)weaponEnd.x, (int)weaponEnd.y, {150, 150, 150, 255});
         return;
     }
     
     // Get texture dimensions
-    int textureWidth, textureHeight;
-    SDL_QueryTexture(weaponTexture, nullptr, nullptr, &textureWidth, &textureHeight);
+    int textureWidth = 0, textureHeight = 0;
+    TextureCache::instance().getSize(weaponTexture, textureWidth, textureHeight);
     
     // Scale down the weapon sprite to much smaller size
     float scale = 0.33f;
@@ -352,28 +339,20 @@ void Weapon::render(SDL_Renderer* renderer, const Vector2& weaponPos, const Vect
     };
     
     // Render rotated weapon sprite
-    SDL_RenderCopyEx(renderer, weaponTexture, nullptr, &destRect, angle, nullptr, SDL_FLIP_NONE);
+    SpriteBatch::instance().copyEx(weaponTexture, nullptr, destRect, angle, SDL_FLIP_NONE);
     
     // Only show muzzle flash if this weapon just fired (timer > 0.05 means very recent)
     if (muzzleFlashTimer > 0.05f) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 100, 255);
-        
         Vector2 muzzlePos = weaponPos + weaponDirection * 15;
         
         // Flash circle - smaller and less intrusive
         int flashRadius = 4;
-        for (int x = -flashRadius; x <= flashRadius; x++) {
-            for (int y = -flashRadius; y <= flashRadius; y++) {
-                if (x*x + y*y <= flashRadius*flashRadius) {
-                    SDL_RenderDrawPoint(renderer, (int)muzzlePos.x + x, (int)muzzlePos.y + y);
-                }
-            }
-        }
+        PrimitiveCache::instance().drawCircle((int)muzzlePos.x, (int)muzzlePos.y, flashRadius, { 255, 255, 100, 255 });
     }
 }
 
 void Weapon::fire(const Vector2& weaponPos, const Vector2& direction, 
-                 std::vector<std::unique_ptr<Bullet>>& bullets,
+                 BulletPool& bullets,
                  const Player& player) {
     
     // Melee weapons don't create bullets - they will be handled by Game's melee collision detection
@@ -389,49 +368,38 @@ void Weapon::fire(const Vector2& weaponPos, const Vector2& direction,
     // Handle special firing patterns for different weapon types
     if (type == WeaponType::SHOTGUN) {
         // Shotgun fires 5 pellets with spread
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> spreadAngle(-0.2617f, 0.2617f); // ±15 degrees in radians
+        const float spreadAngle = 0.2617f; // ±15 degrees in radians
         
         int finalDamage = calculateDamage(player);
         
         // Fire 5 pellets
         for (int i = 0; i < 5; i++) {
             float baseAngle = atan2(direction.y, direction.x);
-            float pelletAngle = baseAngle + spreadAngle(gen);
+            float pelletAngle = baseAngle + rng(RandomStream::WEAPONS).range(-spreadAngle, spreadAngle);
             Vector2 pelletDirection(cos(pelletAngle), sin(pelletAngle));
             
             // Check for critical hit for each pellet
-            std::uniform_real_distribution<float> critRoll(0.0f, 1.0f);
             int pelletDamage = finalDamage;
-            if (critRoll(gen) < stats.critChance) {
+            if (rng(RandomStream::COMBAT).chance(stats.critChance)) {
                 pelletDamage = (int)(pelletDamage * stats.critMultiplier);
             }
             
-            bullets.push_back(std::make_unique<Bullet>(weaponPos, pelletDirection, pelletDamage, stats.range, 350.0f, BulletType::SHOTGUN));
+            bullets.spawn(weaponPos, pelletDirection, pelletDamage, stats.range, 350.0f, BulletType::SHOTGUN);
         }
         return;
     }
     
     // Add inaccuracy for SMG
     if (type == WeaponType::SMG) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> inaccuracy(-0.2f, 0.2f);
-        
         float angle = atan2(fireDirection.y, fireDirection.x);
-        angle += inaccuracy(gen);
+        angle += rng(RandomStream::WEAPONS).range(-0.2f, 0.2f);
         fireDirection = Vector2(cos(angle), sin(angle));
     }
     
     int finalDamage = calculateDamage(player);
     
     // Check for critical hit
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> critRoll(0.0f, 1.0f);
-    
-    if (critRoll(gen) < stats.critChance) {
+    if (rng(RandomStream::COMBAT).chance(stats.critChance)) {
         finalDamage = (int)(finalDamage * stats.critMultiplier);
     }
     
@@ -453,12 +421,12 @@ void Weapon::fire(const Vector2& weaponPos, const Vector2& direction,
             break;
     }
     
-    bullets.push_back(std::make_unique<Bullet>(weaponPos, fireDirection, finalDamage, stats.range, bulletSpeed, bulletType));
+    bullets.spawn(weaponPos, fireDirection, finalDamage, stats.range, bulletSpeed, bulletType);
     
     // Special weapon effects
     if (type == WeaponType::PISTOL) {
         // Pistol pierces 1 enemy with -50% damage
-        // This will be handled in the Bullet class collision detection
+        // This will be handled in Game::checkCollisions
     }
 }
 
@@ -4,7 +4,7 @@
 #include <cmath>
 #include <memory>
 #include "Vector2.h"
-#include "Bullet.h"
+#include "BulletPool.h"
 
 class Enemy;
 class Player;
@@ -49,12 +49,12 @@ public:
     Weapon(WeaponType type, WeaponTier tier = WeaponTier::TIER_1);
     virtual ~Weapon();
     
-    // Initialize weapon with renderer for texture loading
-    void initialize(SDL_Renderer* renderer);
+    // Acquire the weapon sprite from the shared texture cache
+    void initialize();
     
     virtual void update(float deltaTime, const Vector2& weaponPos, 
                        const Vector2& aimDirection,
-                       std::vector<std::unique_ptr<Bullet>>& bullets,
+                       BulletPool& bullets,
                        const Player& player);
     
     virtual void render(SDL_Renderer* renderer, const Vector2& weaponPos, const Vector2& weaponDirection);
@@ -76,10 +76,12 @@ public:
     Vector2 getWeaponTipPosition(const Vector2& weaponPos, const Vector2& direction) const;
     Vector2 getOrbitingPosition(const Vector2& playerPos) const;
     float getOrbitingRadius() const;
+    // Seconds before the orbiting brick can hit the same enemy again
+    float getOrbitingHitCooldown() const { return orbitHitCooldown; }
     
 protected:
     virtual void fire(const Vector2& weaponPos, const Vector2& direction, 
-                     std::vector<std::unique_ptr<Bullet>>& bullets,
+                     BulletPool& bullets,
                      const Player& player);
     
     // Initialize weapon stats based on type
@@ -104,13 +106,14 @@ protected:
     
     // Sprite rendering
     SDL_Texture* weaponTexture;
-    void loadWeaponTexture(SDL_Renderer* renderer);
+    void loadWeaponTexture();
 
     // Orbiting weapon state
     float orbitAngle = 0.0f;
     float orbitRadius = 70.0f;
     float orbitAngularSpeed = 2.5f; // radians/sec
     float orbitHitRadius = 16.0f;
+    float orbitHitCooldown = 0.5f;
 };
 
 inline void Weapon::initializeOrbitingBrickStats() {
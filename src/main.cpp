@@ -1,15 +1,48 @@
 #include "Game.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 int main(int argc, char* args[]) {
+    GameConfig config;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(args[i], "--headless") == 0) {
+            // Simulation only (no window); the shop closes itself between waves
+            config.headless = true;
+            config.autoCloseShop = true;
+        } else if (std::strcmp(args[i], "--windowed") == 0) {
+            config.fullscreen = false;
+        } else if (std::strcmp(args[i], "--no-vsync") == 0) {
+            config.vsync = false;
+        } else if (std::strcmp(args[i], "--tickrate") == 0 && i + 1 < argc) {
+            int tickRate = std::atoi(args[++i]);
+            if (tickRate > 0) {
+                config.tickRate = tickRate;
+            }
+        } else if (std::strcmp(args[i], "--seed") == 0 && i + 1 < argc) {
+            config.seed = std::strtoull(args[++i], nullptr, 10);
+        } else if (std::strcmp(args[i], "--threads") == 0 && i + 1 < argc) {
+            config.workerThreads = std::atoi(args[++i]);
+        } else if (std::strcmp(args[i], "--record") == 0 && i + 1 < argc) {
+            config.recordPath = args[++i];
+        } else if (std::strcmp(args[i], "--replay") == 0 && i + 1 < argc) {
+            // Seed, tick rate and shop behaviour come from the file
+            config.replayPath = args[++i];
+        }
+    }
+    
     Game game;
     
-    if (!game.init()) {
+    if (!game.init(config)) {
         std::cout << "Failed to initialize game!" << std::endl;
         return -1;
     }
     
     game.run();
     
+    if (game.isHeadless()) {
+        std::cout << "Headless run finished at wave " << game.getWave() << " with score " << game.getScore() << std::endl;
+    }
+    
     return 0;
-}
\ No newline at end of file
+}